@@ -1,15 +1,15 @@
 
 #include "SUBrowseNode.h"
-#include "Engine/Blueprint.h"
-#include "Engine/BlueprintGeneratedClass.h"
-#include "Engine/Level.h"
 #include "GraphEditorSettings.h"
+#include "SGraphPanel.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EditorClassUtils.h"
 #include "SlateOptMacros.h"
+#include "UBrowseGraph.h"
 #include "UBrowseNode.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Images/SImage.h"
+#include "Widgets/Text/STextBlock.h"
 #include "Widgets/Layout/SSpacer.h"
 #include "Widgets/Layout/SBox.h"
 
@@ -23,61 +23,124 @@ void SUBrowseNode::Construct(const FArguments& InArgs, UBrowseNode* InNode)
 
 FSlateColor SUBrowseNode::GetNodeTitleColor() const
 {
-	const UObject* Obj = static_cast<UBrowseNode*>(GraphNode)->GetUObject();
-	if (Obj == nullptr)
+	// the node worked out what it is when it was set up, nothing to look up on paint
+	const UGraphEditorSettings* Settings = GetDefault<UGraphEditorSettings>();
+	switch (static_cast<UBrowseNode*>(GraphNode)->GetColor())
 	{
+	case EUBrowseNodeColor::Missing:
 		return GetErrorColor();
+	case EUBrowseNodeColor::Class:
+		return Settings->ClassPinTypeColor;
+	case EUBrowseNodeColor::Blueprint:
+		return Settings->StructPinTypeColor;
+	case EUBrowseNodeColor::BlueprintGeneratedClass:
+		return Settings->SoftClassPinTypeColor;
+	case EUBrowseNodeColor::Package:
+		return Settings->WildcardPinTypeColor;
+	case EUBrowseNodeColor::Level:
+		return Settings->BooleanPinTypeColor;
+	case EUBrowseNodeColor::Actor:
+		return Settings->VectorPinTypeColor;
+	default:
+		return Settings->ObjectPinTypeColor;
 	}
-	if (Obj->IsA(UClass::StaticClass()))
-	{
-		return GetDefault<UGraphEditorSettings>()->ClassPinTypeColor;
-	}
-	UClass* Class = Obj->GetClass();
-	if (Class->IsChildOf(UBlueprint::StaticClass()))
-	{
-		return GetDefault<UGraphEditorSettings>()->StructPinTypeColor;
-	}
-	if (Class->IsChildOf(UBlueprintGeneratedClass::StaticClass()))
+}
+
+const FSlateBrush* SUBrowseNode::GetBodyBrush() const
+{
+	return bLowDetail ? FAppStyle::GetBrush("WhiteBrush") : FAppStyle::GetBrush("Graph.Node.Body");
+}
+
+FSlateColor SUBrowseNode::GetBodyColor() const
+{
+	return bLowDetail ? GetNodeTitleColor() : FLinearColor::White;
+}
+
+void SUBrowseNode::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SGraphNode::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// a frame after the detail changed, so the widgets were measured with it
+	if (bLayoutPending)
 	{
-		return GetDefault<UGraphEditorSettings>()->SoftClassPinTypeColor;
+		bLayoutPending = false;
+		LayoutGraph();
 	}
-	if (Class->IsChildOf(UBlueprint::StaticClass()))
+	UpdateDetail();
+}
+
+void SUBrowseNode::SetOwner(const TSharedRef<SGraphPanel>& OwnerPanel)
+{
+	SGraphNode::SetOwner(OwnerPanel);
+	// before anything is laid out, so the layout sees the size of the detail actually shown
+	UpdateDetail();
+}
+
+void SUBrowseNode::UpdateDetail()
+{
+	TSharedPtr<SGraphPanel> OwnerPanel = OwnerGraphPanelPtr.Pin();
+	if (!OwnerPanel.IsValid() || !TitleBox.IsValid())
 	{
-		return GetDefault<UGraphEditorSettings>()->SoftObjectPinTypeColor;
+		return;
 	}
-	if (Class->IsChildOf(UPackage::StaticClass()))
+
+	const bool bWantLowDetail = OwnerPanel->GetCurrentLOD() <= LowDetailLOD;
+	if (bHasDetail && (bWantLowDetail == bLowDetail))
 	{
-		return GetDefault<UGraphEditorSettings>()->WildcardPinTypeColor;
+		return;
 	}
-	if (Class->IsChildOf(ULevel::StaticClass()))
+	const bool bWasShown = bHasDetail;
+	bHasDetail = true;
+	bLowDetail = bWantLowDetail;
+
+	if (bLowDetail)
 	{
-		return GetDefault<UGraphEditorSettings>()->BooleanPinTypeColor;
+		if (!LowDetailTitle.IsValid())
+		{
+			LowDetailTitle = CreateLowDetailTitle();
+		}
+		TitleBox->SetContent(LowDetailTitle.ToSharedRef());
+		DescriptionBox->SetContent(SNullWidget::NullWidget);
 	}
-	if (Class->IsChildOf(AActor::StaticClass()))
+	else
 	{
-		return GetDefault<UGraphEditorSettings>()->VectorPinTypeColor;
+		if (!FullTitle.IsValid())
+		{
+			FullTitle = CreateFullTitle();
+			FullDescription = CreateFullDescription();
+
+			// laid out at the low detail size, the neighbours have to make room. Shrinking back never overlaps
+			UBrowseGraph* BrowseGraph = Cast<UBrowseGraph>(GraphNode->GetGraph());
+			if (bWasShown && (BrowseGraph != nullptr))
+			{
+				BrowseGraph->MarkLayoutDirty();
+				bLayoutPending = true;
+			}
+		}
+		TitleBox->SetContent(FullTitle.ToSharedRef());
+		DescriptionBox->SetContent(FullDescription.ToSharedRef());
 	}
-	return GetDefault<UGraphEditorSettings>()->ObjectPinTypeColor;
 }
 
-
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SUBrowseNode::UpdateGraphNode()
 {
 	OutputPins.Empty();
 	RightNodeBox.Reset();
 	LeftNodeBox.Reset();
+	FullTitle.Reset();
+	FullDescription.Reset();
+	LowDetailTitle.Reset();
+	bHasDetail = false;
+	bLayoutPending = false;
 
 	UpdateErrorInfo();
 
 	TSharedPtr<SVerticalBox>    MainVerticalBox;
-	TSharedPtr<SErrorText>      ErrorText;
-	TSharedPtr<SNodeTitle>      NodeTitle = SNew(SNodeTitle, GraphNode);
 
 	ContentScale.Bind(this, &SUBrowseNode::GetContentScale);
 
-	UBrowseNode *EdGraphNode = Cast<UBrowseNode>(GraphNode);
-
+	// the title and description are filled in by UpdateDetail, the pins stay the same at every zoom
 	GetOrAddSlot(ENodeZone::Center)
 	.HAlign(HAlign_Center)
 	.VAlign(VAlign_Center)
@@ -87,7 +150,8 @@ void SUBrowseNode::UpdateGraphNode()
 		.AutoHeight()
 		[
 			SNew(SBorder)
-			.BorderImage(FAppStyle::GetBrush("Graph.Node.Body"))
+			.BorderImage(this, &SUBrowseNode::GetBodyBrush)
+			.BorderBackgroundColor(this, &SUBrowseNode::GetBodyColor)
 			.Padding(0)
 			[
 				SNew(SVerticalBox)
@@ -97,129 +161,170 @@ void SUBrowseNode::UpdateGraphNode()
 				.HAlign(HAlign_Fill)
 				.VAlign(VAlign_Top)
 				[
-					SNew(SOverlay)
-					+ SOverlay::Slot()
-					[
-						SNew(SImage)
-						.Image(FAppStyle::GetBrush("Graph.Node.TitleGloss"))
-					]
-					+ SOverlay::Slot()
-					.HAlign(HAlign_Left)
-					.VAlign(VAlign_Center)
+					SAssignNew(TitleBox, SBox)
+				]
+				+ SVerticalBox::Slot()
+					.AutoHeight()
+					.HAlign(HAlign_Fill)
+					.VAlign(VAlign_Top)
 					[
+						// NODE CONTENT AREA
 						SNew(SBorder)
-						.BorderImage(FAppStyle::GetBrush("Graph.Node.ColorSpill"))
-						.Padding(FMargin(10, 5, 30, 3))
-						.BorderBackgroundColor(this, &SUBrowseNode::GetNodeTitleColor)
+						.BorderImage(FAppStyle::GetBrush("NoBorder"))
+						.HAlign(HAlign_Fill)
+						.VAlign(VAlign_Fill)
+						.Padding(FMargin(0, 3))
 						[
-							SNew(SVerticalBox) 
-							+ SVerticalBox::Slot()
-							.AutoHeight()
+							SNew(SHorizontalBox)
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							.VAlign(VAlign_Center)
 							[
-								SNew(SHorizontalBox)
-								+ SHorizontalBox::Slot()
-								.AutoWidth()
+								// LEFT
+								SNew(SBox)
+								.WidthOverride(120)
 								[
-									EdGraphNode->GetUObject() != nullptr ?
-										FEditorClassUtils::GetDocumentationLinkWidget(EdGraphNode->GetUObject()->GetClass()) : 
-										SNullWidget::NullWidget
-								]
-								+ SHorizontalBox::Slot()
-								.AutoWidth()
-								[
-									SNew(STextBlock)
-									.Text(NodeTitle.Get(), &SNodeTitle::GetHeadTitle)
+									SAssignNew(LeftNodeBox, SVerticalBox)
 								]
 							]
-							+ SVerticalBox::Slot()
-							.AutoHeight()
+							+ SHorizontalBox::Slot()
+							.VAlign(VAlign_Center)
+							.HAlign(HAlign_Center)
+							.FillWidth(1.0f)
 							[
-								NodeTitle.ToSharedRef()
+								SAssignNew(DescriptionBox, SBox)
+							]
+							+ SHorizontalBox::Slot()
+							.AutoWidth()
+							.VAlign(VAlign_Center)
+							[
+								// RIGHT
+								SNew(SBox)
+								.WidthOverride(120)
+								[
+									SAssignNew(RightNodeBox, SVerticalBox)
+								]
 							]
-						]
-					]
-					+ SOverlay::Slot()
-					.VAlign(VAlign_Top)
-					[
-						SNew(SBorder)
-						.BorderImage(FAppStyle::GetBrush("Graph.Node.TitleHighlight"))
-						.Visibility(EVisibility::HitTestInvisible)
-						[
-							SNew(SSpacer)
-							.Size(FVector2D(20, 20))
 						]
 					]
 			]
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			.Padding(1.0f)
+		]
+	];
+	CreateBelowWidgetControls(MainVerticalBox);
+	CreatePinWidgets();
+	UpdateDetail();
+}
+
+TSharedRef<SWidget> SUBrowseNode::CreateFullTitle()
+{
+	TSharedPtr<SErrorText>      ErrorText;
+	TSharedPtr<SNodeTitle>      NodeTitle = SNew(SNodeTitle, GraphNode);
+
+	UBrowseNode *EdGraphNode = Cast<UBrowseNode>(GraphNode);
+
+	return SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(SOverlay)
+			+ SOverlay::Slot()
 			[
-				// POPUP ERROR MESSAGE : DO I need this?
-				SAssignNew(ErrorText, SErrorText)
-				.BackgroundColor(this, &SUBrowseNode::GetErrorColor)
-				.ToolTipText(this, &SUBrowseNode::GetErrorMsgToolTip)
+				SNew(SImage)
+				.Image(FAppStyle::GetBrush("Graph.Node.TitleGloss"))
 			]
-			+ SVerticalBox::Slot()
-				.AutoHeight()
-				.HAlign(HAlign_Fill)
-				.VAlign(VAlign_Top)
+			+ SOverlay::Slot()
+			.HAlign(HAlign_Left)
+			.VAlign(VAlign_Center)
+			[
+				SNew(SBorder)
+				.BorderImage(FAppStyle::GetBrush("Graph.Node.ColorSpill"))
+				.Padding(FMargin(10, 5, 30, 3))
+				.BorderBackgroundColor(this, &SUBrowseNode::GetNodeTitleColor)
 				[
-					// NODE CONTENT AREA
-					SNew(SBorder)
-					.BorderImage(FAppStyle::GetBrush("NoBorder"))
-					.HAlign(HAlign_Fill)
-					.VAlign(VAlign_Fill)
-					.Padding(FMargin(0, 3))
+					SNew(SVerticalBox) 
+					+ SVerticalBox::Slot()
+					.AutoHeight()
 					[
 						SNew(SHorizontalBox)
 						+ SHorizontalBox::Slot()
 						.AutoWidth()
-						.VAlign(VAlign_Center)
 						[
-							// LEFT
-							SNew(SBox)
-							.WidthOverride(120)
-							[
-								SAssignNew(LeftNodeBox, SVerticalBox)
-							]
-						]
-						+ SHorizontalBox::Slot()
-						.VAlign(VAlign_Center)
-						.HAlign(HAlign_Center)
-						.FillWidth(1.0f)
-						[
-							SNew(SVerticalBox)
-							+ SVerticalBox::Slot()
-							.AutoHeight()
-							[
-								SNew(STextBlock)
-								.Text(EdGraphNode->GetShortDesc())
-							]
-							+ SVerticalBox::Slot()
-							.AutoHeight()
-							[
-								SNew(STextBlock)
-								.Text(EdGraphNode->GetLongDesc())
-							]
+							EdGraphNode->GetUObject() != nullptr ?
+								FEditorClassUtils::GetDocumentationLinkWidget(EdGraphNode->GetUObject()->GetClass()) : 
+								SNullWidget::NullWidget
 						]
 						+ SHorizontalBox::Slot()
 						.AutoWidth()
-						.VAlign(VAlign_Center)
 						[
-							// RIGHT
-							SNew(SBox)
-							.WidthOverride(120)
-							[
-								SAssignNew(RightNodeBox, SVerticalBox)
-							]
+							SNew(STextBlock)
+							.Text(NodeTitle.Get(), &SNodeTitle::GetHeadTitle)
 						]
 					]
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					[
+						NodeTitle.ToSharedRef()
+					]
+				]
+			]
+			+ SOverlay::Slot()
+			.VAlign(VAlign_Top)
+			[
+				SNew(SBorder)
+				.BorderImage(FAppStyle::GetBrush("Graph.Node.TitleHighlight"))
+				.Visibility(EVisibility::HitTestInvisible)
+				[
+					SNew(SSpacer)
+					.Size(FVector2D(20, 20))
 				]
 			]
 		]
-	];
-	CreateBelowWidgetControls(MainVerticalBox);
-	CreatePinWidgets();
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(1.0f)
+		[
+			// POPUP ERROR MESSAGE : DO I need this?
+			SAssignNew(ErrorText, SErrorText)
+			.BackgroundColor(this, &SUBrowseNode::GetErrorColor)
+			.ToolTipText(this, &SUBrowseNode::GetErrorMsgToolTip)
+		];
+}
+
+TSharedRef<SWidget> SUBrowseNode::CreateFullDescription()
+{
+	UBrowseNode *EdGraphNode = Cast<UBrowseNode>(GraphNode);
+
+	return SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(EdGraphNode->GetShortDesc())
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			// summary nodes count up as they are expanded
+			SNew(STextBlock)
+			.Text_Lambda([WeakNode = TWeakObjectPtr<UBrowseNode>(EdGraphNode)]() { return WeakNode.IsValid() ? WeakNode->GetLongDesc() : FText::GetEmpty(); })
+		];
+}
+
+TSharedRef<SWidget> SUBrowseNode::CreateLowDetailTitle()
+{
+	// the object name alone, large enough to read from far out. Summary nodes keep their count
+	const UBrowseNode* EdGraphNode = Cast<UBrowseNode>(GraphNode);
+	const UObject* Obj = EdGraphNode->GetUObject();
+	const FText Label = (EdGraphNode->IsSummary() || (Obj == nullptr)) ? EdGraphNode->GetNodeTitle(ENodeTitleType::FullTitle) : FText::FromString(Obj->GetName());
+
+	return SNew(SBox)
+		.Padding(FMargin(10, 5))
+		[
+			SNew(STextBlock)
+			.Text(Label)
+			.Font(FCoreStyle::GetDefaultFontStyle("Bold", 18))
+			.ColorAndOpacity(FLinearColor::Black)
+		];
 }
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
@@ -228,68 +333,37 @@ bool SUBrowseNode::RequiresSecondPassLayout() const
 	return true;
 }
 
-void SUBrowseNode::PerformSecondPassLayout(const TMap< UObject*, TSharedRef<SNode> >& NodeToWidgetLookup) const
+void SUBrowseNode::LayoutGraph() const
 {
-	UBrowseNode* TransNode = CastChecked<UBrowseNode>(GraphNode);
-	if (!TransNode->IsFixedInPlace())
+	// every node that grew asks, whichever comes first lays the graph out for all of them
+	UBrowseGraph* BrowseGraph = Cast<UBrowseGraph>(GraphNode->GetGraph());
+	TSharedPtr<SGraphPanel> OwnerPanel = OwnerGraphPanelPtr.Pin();
+	if ((BrowseGraph == nullptr) || !OwnerPanel.IsValid() || !BrowseGraph->IsLayoutDirty())
+	{
 		return;
-	const float NodeGap{50.0f};
-	bool bStartedLeftHandLayout{ false };
-	float LeftHandSide{ 0.0f };
-	bool bStartedRightHandLayout = false;
-	float RightHandSide{ 0.0f };
+	}
 
-	const TArray<UEdGraphPin*>& Pins{TransNode->GetAllPins()};
+	BrowseGraph->LayoutNodes([&OwnerPanel](const UEdGraphNode* Node)
+	{
+		TSharedPtr<SGraphNode> NodeWidget = OwnerPanel->GetNodeWidgetFromGuid(Node->NodeGuid);
+		return NodeWidget.IsValid() ? NodeWidget->GetDesiredSize() : FVector2D(300.0f, 100.0f);
+	});
+}
 
-	// line them up on the left
-	for(auto& Pin : Pins)
+void SUBrowseNode::PerformSecondPassLayout(const TMap< UObject*, TSharedRef<SNode> >& NodeToWidgetLookup) const
+{
+	// the whole graph is laid out at once, by whichever node gets here first after it changed
+	UBrowseGraph* BrowseGraph = Cast<UBrowseGraph>(GraphNode->GetGraph());
+	if ((BrowseGraph == nullptr) || !BrowseGraph->IsLayoutDirty())
 	{
-		if (Pin->Direction == EGPD_Input)
-		{
-			if ((Pin->GetName() == TEXT("Inner")) || (Pin->GetName() == TEXT("Outer")))
-			{
-				continue;
-			}
-			if (!bStartedLeftHandLayout)
-			{
-				LeftHandSide = TransNode->NodePosX;
-				bStartedLeftHandLayout = true;
-			}
-			if (Pin->LinkedTo.Num() < 1)
-				continue;
-			// get the node we want to go on the left
-			UEdGraphPin* LinkedPin = Pin->LinkedTo[0];
-			UBrowseNode* LeftNode = Cast<UBrowseNode>(LinkedPin->GetOwningNode());
-			FVector2D LeftNodeSize = NodeToWidgetLookup.FindChecked(LeftNode)->GetDesiredSize();		
-			LeftNode->NodePosX = (LeftHandSide - LeftNodeSize.X) - NodeGap;
-			LeftHandSide = LeftNode->NodePosX;
-		}
+		return;
 	}
 
-	// line them up on the right
-	for(auto Pin : Pins)
+	BrowseGraph->LayoutNodes([&NodeToWidgetLookup](const UEdGraphNode* Node)
 	{
-		if (Pin->Direction == EGPD_Output)
-		{
-			if ((Pin->GetName() == "Inner") || (Pin->GetName() == "Outer"))
-			{
-				continue;
-			}
-			if (!bStartedRightHandLayout)
-			{
-				FVector2D TransNodeSize = NodeToWidgetLookup.FindChecked(TransNode)->GetDesiredSize();
-				RightHandSide = (TransNode->NodePosX + TransNodeSize.X) + NodeGap;
-				bStartedRightHandLayout = true;
-			}		
-			if (Pin->LinkedTo.Num() < 1)
-				continue;
-			UEdGraphPin* LinkedPin = Pin->LinkedTo[0];
-			UBrowseNode* RightNode = Cast<UBrowseNode>(LinkedPin->GetOwningNode());
-			FVector2D RightNodeSize = NodeToWidgetLookup.FindChecked(RightNode)->GetDesiredSize();	
-			RightNode->NodePosX = RightHandSide;
-			RightHandSide = RightNode->NodePosX + RightNodeSize.X + NodeGap;
-		}
-	}
+		const TSharedRef<SNode>* NodeWidget = NodeToWidgetLookup.Find(const_cast<UEdGraphNode*>(Node));
+		return NodeWidget != nullptr ? (*NodeWidget)->GetDesiredSize() : FVector2D(300.0f, 100.0f);
+	});
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
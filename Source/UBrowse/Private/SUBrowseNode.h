@@ -2,6 +2,7 @@
 
 #include "SGraphNode.h"
 
+class SBox;
 class UBrowseNode;
 
 class SUBrowseNode : public SGraphNode
@@ -14,9 +15,46 @@ public:
 
 	FSlateColor GetNodeTitleColor() const;
 
+	/* Most detail the graph can be zoomed out to before nodes turn into plain class colored boxes */
+	static constexpr EGraphRenderingLOD::Type LowDetailLOD = EGraphRenderingLOD::LowDetail;
+
+	// SWidget Implementation
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	// SWidget Implementation
+
 	// SGraphNode Implementation
 	virtual void UpdateGraphNode() override;
+	virtual void SetOwner(const TSharedRef<SGraphPanel>& OwnerPanel) override;
 	virtual bool RequiresSecondPassLayout() const override;
 	virtual void PerformSecondPassLayout(const TMap< UObject*, TSharedRef<SNode> >& NodeToWidgetLookup) const override;
 	// SGraphNode Implementation
-};
\ No newline at end of file
+
+private:
+	/* Show the full or the low detail title and description to match the zoom of the owning panel */
+	void UpdateDetail();
+
+	/* Lay the whole graph out again from the sizes the node widgets on the owning panel were last measured at */
+	void LayoutGraph() const;
+
+	TSharedRef<SWidget> CreateFullTitle();
+	TSharedRef<SWidget> CreateFullDescription();
+	TSharedRef<SWidget> CreateLowDetailTitle();
+
+	const FSlateBrush* GetBodyBrush() const;
+	FSlateColor GetBodyColor() const;
+
+	TSharedPtr<SBox> TitleBox;
+	TSharedPtr<SBox> DescriptionBox;
+
+	/* Only built the first time they are shown, then kept for when the zoom comes back */
+	TSharedPtr<SWidget> FullTitle;
+	TSharedPtr<SWidget> FullDescription;
+	TSharedPtr<SWidget> LowDetailTitle;
+
+	/* Set once the node is on a panel and knows which detail to show */
+	bool bHasDetail = false;
+	bool bLowDetail = false;
+
+	/* Set when the node first grows to full detail after being laid out smaller, the graph is laid out again once it is measured */
+	bool bLayoutPending = false;
+};
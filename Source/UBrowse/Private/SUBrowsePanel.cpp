@@ -2,6 +2,7 @@
 #include "SUBrowsePanel.h"
 
 #include "UBrowseGraph.h"
+#include "UBrowseReferenceIndex.h"
 #include "UBrowseSchema.h"
 #include "Widgets/Text/STextBlock.h"
 
@@ -13,6 +14,8 @@ void SUBrowsePanel::Construct(const FArguments& InArgs)
     BrowserGraphPtr = NewObject<UBrowseGraph>(UBrowseGraph::StaticClass());
     BrowserGraphPtr->Schema = UBrowseSchema::StaticClass();
     BrowserGraphPtr->AddToRoot();
+    ReferenceIndex = MakeShared<FUBrowseReferenceIndexCache>();
+    BrowserGraphPtr->SetReferenceIndex(ReferenceIndex);
     OnNewObjectView.BindSP(this, &SUBrowsePanel::OnNewRootNode);
     // appearance
     // TODO: Name of object at root
@@ -49,14 +52,30 @@ void SUBrowsePanel::Tick(const FGeometry& AllottedGeometry, const double InCurre
 
 FGraphAppearanceInfo SUBrowsePanel::GetAppearanceInfo() const
 {
-    return AppearanceInfo;
+    FGraphAppearanceInfo Info = AppearanceInfo;
+    if (BrowserGraphPtr->IsWaitingForReferences())
+    {
+        Info.InstructionText = LOCTEXT("BuildingReferenceIndex", "Finding references...");
+    }
+    else
+    {
+        Info.WarningText = BrowserGraphPtr->GetStatusText();
+    }
+    return Info;
 }
 
-void SUBrowsePanel::OnNewRootNode(TSharedPtr<FBrowserObject> InObject)
+void SUBrowsePanel::OnNewRootNode(TWeakObjectPtr<UObject> InObject)
 {
-    AppearanceInfo.CornerText = FText::FromString(GetNameSafe(InObject->Object.Get()));
-    AppearanceInfo.ReadOnlyText = FText::FromString(GetNameSafe(InObject->Object.Get()));
-    BrowserGraphPtr->RefreshGraph(InObject->Object.Get());
+    AppearanceInfo.CornerText = FText::FromString(GetNameSafe(InObject.Get()));
+    AppearanceInfo.ReadOnlyText = FText::FromString(GetNameSafe(InObject.Get()));
+    BrowserGraphPtr->RefreshGraph(InObject.Get());
+}
+
+void SUBrowsePanel::ShowWhyAlive(TWeakObjectPtr<UObject> InObject)
+{
+    AppearanceInfo.CornerText = FText::FromString(GetNameSafe(InObject.Get()));
+    AppearanceInfo.ReadOnlyText = FText::FromString(GetNameSafe(InObject.Get()));
+    BrowserGraphPtr->ShowWhyAlive(InObject);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -3,12 +3,13 @@
 #include "GraphEditor.h"
 #include "UBrowse.h"
 
+class FUBrowseReferenceIndexCache;
 class UBrowseGraph;
 
 class SUBrowsePanel : public SCompoundWidget
 {
 public:
-    DECLARE_DELEGATE_OneParam(FOnNewObjectView, TSharedPtr<FBrowserObject>);
+    DECLARE_DELEGATE_OneParam(FOnNewObjectView, TWeakObjectPtr<UObject>);
 
     // clang-format off
     SLATE_BEGIN_ARGS(SUBrowsePanel) {}
@@ -28,7 +29,10 @@ public:
     void Construct(const FArguments& InArgs);
 
     /* Called when a new root node is selected */
-    void OnNewRootNode(TSharedPtr<FBrowserObject> InObject);
+    void OnNewRootNode(TWeakObjectPtr<UObject> InObject);
+
+    /* Switch the graph to the chain of references keeping an object alive */
+    void ShowWhyAlive(TWeakObjectPtr<UObject> InObject);
 
     FGraphAppearanceInfo GetAppearanceInfo() const;
 
@@ -36,4 +40,6 @@ private:
     FGraphAppearanceInfo AppearanceInfo;
     TSharedPtr<SGraphEditor> GraphEditorPtr;
     UBrowseGraph* BrowserGraphPtr = nullptr;
+    /* Who references whom, built when the reference graph first needs it */
+    TSharedPtr<FUBrowseReferenceIndexCache> ReferenceIndex;
 };
\ No newline at end of file
@@ -10,7 +10,7 @@ class SUBrowsePropertyTableRow
 {
 public:
     SLATE_BEGIN_ARGS(SUBrowsePropertyTableRow) { }
-        SLATE_ARGUMENT(TSharedPtr<FBrowserObject>, Object)
+        SLATE_ARGUMENT(TWeakObjectPtr<UObject>, Object)
         SLATE_ARGUMENT(FText, HighlightText)
     SLATE_END_ARGS()
 public:
@@ -22,7 +22,7 @@ public:
     void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
     {
         Object = InArgs._Object;
-		if (UObject* Obj = InArgs._Object->Object.Get())
+		if (UObject* Obj = InArgs._Object.Get())
 		{
 			// Get selection icon based on actor(s) classes and add before the selection label
 			ClassIcon = FClassIconFinder::FindThumbnailForClass(Obj->GetClass());
@@ -31,7 +31,7 @@ public:
     }
 
     private:
-        TSharedPtr<FBrowserObject> Object;
+        TWeakObjectPtr<UObject> Object;
 
         const FSlateBrush* ClassIcon;
 
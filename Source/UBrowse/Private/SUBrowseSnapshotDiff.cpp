@@ -0,0 +1,235 @@
+#include "SUBrowseSnapshotDiff.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Misc/Paths.h"
+#include "Styling/AppStyle.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SSplitter.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "SUBrowseSnapshotDiff"
+
+namespace
+{
+	typedef TSharedPtr<FUBrowseSnapshotDiff::FRow> FDiffRowPtr;
+
+	class SSnapshotDiffRow : public SMultiColumnTableRow<FDiffRowPtr>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SSnapshotDiffRow) {}
+			SLATE_ARGUMENT(FDiffRowPtr, Row)
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+		{
+			Row = InArgs._Row;
+			SMultiColumnTableRow<FDiffRowPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if (ColumnName == "Name")
+			{
+				Text = FText::FromString(Row->Name);
+			}
+			else if (ColumnName == "CountBefore")
+			{
+				Text = FText::AsNumber(Row->CountBefore);
+			}
+			else if (ColumnName == "CountAfter")
+			{
+				Text = FText::AsNumber(Row->CountAfter);
+			}
+			else if (ColumnName == "CountDelta")
+			{
+				Text = FormatDelta(FText::AsNumber(FMath::Abs(Row->GetCountDelta())), Row->GetCountDelta());
+			}
+			else if (ColumnName == "SizeBefore")
+			{
+				Text = FText::AsMemory(Row->SizeBefore);
+			}
+			else if (ColumnName == "SizeAfter")
+			{
+				Text = FText::AsMemory(Row->SizeAfter);
+			}
+			else if (ColumnName == "SizeDelta")
+			{
+				Text = FormatDelta(FText::AsMemory(FMath::Abs(Row->GetSizeDelta())), Row->GetSizeDelta());
+			}
+			return SNew(STextBlock).Text(Text);
+		}
+
+	private:
+		static FText FormatDelta(const FText& Magnitude, int64 Delta)
+		{
+			if (Delta == 0)
+			{
+				return FText::GetEmpty();
+			}
+			return FText::Format(Delta > 0 ? LOCTEXT("Growth", "+{0}") : LOCTEXT("Shrink", "-{0}"), Magnitude);
+		}
+
+		FDiffRowPtr Row;
+	};
+}
+
+void SUBrowseSnapshotDiff::Construct(const FArguments& InArgs)
+{
+	Diff = InArgs._Diff;
+	check(Diff.IsValid());
+
+	SortRows(Diff->Classes);
+	SortRows(Diff->Packages);
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::Format(LOCTEXT("DiffHeader", "{0} ({1})  ->  {2} ({3})"),
+				FText::FromString(FPaths::GetCleanFilename(Diff->BeforeFilename)), FText::AsDateTime(Diff->BeforeTime),
+				FText::FromString(FPaths::GetCleanFilename(Diff->AfterFilename)), FText::AsDateTime(Diff->AfterTime)))
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			SNew(SSplitter)
+			.Orientation(Orient_Vertical)
+			+ SSplitter::Slot()
+			[
+				MakeListView(LOCTEXT("ClassColumn", "Class"), &Diff->Classes, ClassListView)
+			]
+			+ SSplitter::Slot()
+			[
+				MakeListView(LOCTEXT("PackageColumn", "Package"), &Diff->Packages, PackageListView)
+			]
+		]
+	];
+}
+
+TSharedRef<SWidget> SUBrowseSnapshotDiff::MakeListView(const FText& NameLabel, TArray<FRowPtr>* Rows, TSharedPtr<SListView<FRowPtr> >& OutListView)
+{
+	TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow);
+	auto AddColumn = [this, &HeaderRow](FName ColumnName, const FText& Label, float Width)
+	{
+		HeaderRow->AddColumn(SHeaderRow::Column(ColumnName)
+			.DefaultLabel(Label)
+			.FillWidth(Width)
+			.OnSort(this, &SUBrowseSnapshotDiff::OnSortByChanged)
+			.SortMode(this, &SUBrowseSnapshotDiff::GetColumnSortMode, ColumnName));
+	};
+	AddColumn("Name", NameLabel, 0.4f);
+	AddColumn("CountBefore", LOCTEXT("CountBeforeColumn", "Count Before"), 0.1f);
+	AddColumn("CountAfter", LOCTEXT("CountAfterColumn", "Count After"), 0.1f);
+	AddColumn("CountDelta", LOCTEXT("CountDeltaColumn", "Count Change"), 0.1f);
+	AddColumn("SizeBefore", LOCTEXT("SizeBeforeColumn", "Size Before"), 0.1f);
+	AddColumn("SizeAfter", LOCTEXT("SizeAfterColumn", "Size After"), 0.1f);
+	AddColumn("SizeDelta", LOCTEXT("SizeDeltaColumn", "Size Change"), 0.1f);
+
+	return SNew(SBorder)
+		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
+		.Padding(FMargin(0.0f, 4.0f))
+		[
+			SAssignNew(OutListView, SListView<FRowPtr>)
+			.ListItemsSource(Rows)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SUBrowseSnapshotDiff::OnGenerateRow)
+			.HeaderRow(HeaderRow)
+		];
+}
+
+TSharedRef<ITableRow> SUBrowseSnapshotDiff::OnGenerateRow(FRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SSnapshotDiffRow, OwnerTable).Row(Row);
+}
+
+void SUBrowseSnapshotDiff::OnSortByChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnName, const EColumnSortMode::Type NewSortMode)
+{
+	SortColumn = ColumnName;
+	SortMode = NewSortMode;
+
+	SortRows(Diff->Classes);
+	SortRows(Diff->Packages);
+	ClassListView->RequestListRefresh();
+	PackageListView->RequestListRefresh();
+}
+
+EColumnSortMode::Type SUBrowseSnapshotDiff::GetColumnSortMode(FName ColumnName) const
+{
+	return ColumnName == SortColumn ? SortMode : EColumnSortMode::None;
+}
+
+void SUBrowseSnapshotDiff::SortRows(TArray<FRowPtr>& Rows) const
+{
+	auto GetSortValue = [this](const FRowPtr& Row) -> int64
+	{
+		if (SortColumn == "CountBefore")
+		{
+			return Row->CountBefore;
+		}
+		else if (SortColumn == "CountAfter")
+		{
+			return Row->CountAfter;
+		}
+		else if (SortColumn == "CountDelta")
+		{
+			return Row->GetCountDelta();
+		}
+		else if (SortColumn == "SizeBefore")
+		{
+			return Row->SizeBefore;
+		}
+		else if (SortColumn == "SizeAfter")
+		{
+			return Row->SizeAfter;
+		}
+		return Row->GetSizeDelta();
+	};
+
+	const bool bDescending = SortMode == EColumnSortMode::Descending;
+	if (SortColumn == "Name")
+	{
+		Rows.StableSort([bDescending](const FRowPtr& A, const FRowPtr& B) { return bDescending ? B->Name < A->Name : A->Name < B->Name; });
+	}
+	else
+	{
+		Rows.StableSort([bDescending, &GetSortValue](const FRowPtr& A, const FRowPtr& B)
+		{
+			const int64 ValueA = GetSortValue(A);
+			const int64 ValueB = GetSortValue(B);
+			return bDescending ? ValueB < ValueA : ValueA < ValueB;
+		});
+	}
+}
+
+void SUBrowseSnapshotDiff::OpenWindow(const FString& BeforeFile, const FString& AfterFile)
+{
+	FText Error;
+	TSharedPtr<FUBrowseSnapshotDiff> Diff = FUBrowseSnapshotDiff::Compute(BeforeFile, AfterFile, Error);
+	if (!Diff.IsValid())
+	{
+		FNotificationInfo Info(Error);
+		Info.ExpireDuration = 8.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return;
+	}
+
+	FSlateApplication::Get().AddWindow(
+		SNew(SWindow)
+		.Title(LOCTEXT("DiffWindowTitle", "UBrowse Snapshot Diff"))
+		.ClientSize(FVector2D(1000.0f, 700.0f))
+		[
+			SNew(SUBrowseSnapshotDiff)
+			.Diff(Diff)
+		]);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UBrowseSnapshot.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/SListView.h"
+
+/**
+ * Shows the per class and per package growth between two snapshots, side by side.
+ */
+class SUBrowseSnapshotDiff : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SUBrowseSnapshotDiff) {}
+    SLATE_ARGUMENT(TSharedPtr<FUBrowseSnapshotDiff>, Diff)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    /** Compute the diff of two snapshot files and show it in a new window, reports the error instead if either cannot be read */
+    static void OpenWindow(const FString& BeforeFile, const FString& AfterFile);
+
+private:
+    typedef TSharedPtr<FUBrowseSnapshotDiff::FRow> FRowPtr;
+
+    TSharedRef<SWidget> MakeListView(const FText& NameLabel, TArray<FRowPtr>* Rows, TSharedPtr<SListView<FRowPtr> >& OutListView);
+
+    TSharedRef<ITableRow> OnGenerateRow(FRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable);
+
+    void OnSortByChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnName, const EColumnSortMode::Type NewSortMode);
+
+    EColumnSortMode::Type GetColumnSortMode(FName ColumnName) const;
+
+    void SortRows(TArray<FRowPtr>& Rows) const;
+
+    TSharedPtr<FUBrowseSnapshotDiff> Diff;
+
+    TSharedPtr<SListView<FRowPtr> > ClassListView;
+    TSharedPtr<SListView<FRowPtr> > PackageListView;
+
+    /* Both lists are sorted by the same column */
+    FName SortColumn = "SizeDelta";
+    EColumnSortMode::Type SortMode = EColumnSortMode::Descending;
+};
@@ -14,6 +14,8 @@
 #include "Widgets/Layout/SWidgetSwitcher.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Framework/Application/SlateApplication.h"
 #include "Framework/Docking/TabManager.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "PropertyEditorDelegates.h"
@@ -36,13 +38,28 @@
 #include "ClassViewerModule.h"
 #include "Kismet2/SClassPickerDialog.h"
 #include "PropertyEditorModule.h"
+#include "UBrowseGraph.h"
 #include "UBrowseNode.h"
+#include "UBrowseObjectFlags.h"
 #include "SUBrowserTableRow.h"
 #include "SUBrowsePropertyTableRow.h"
+#include "SUBrowseSnapshotDiff.h"
+#include "DesktopPlatformModule.h"
+#include "IDesktopPlatform.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
 #include "Widgets/SBoxPanel.h"
+#include "UBrowseStats.h"
 
 #define LOCTEXT_NAMESPACE "SUBrowserMenu"
 
+DECLARE_CYCLE_STAT(TEXT("Refresh List"), STAT_UBrowse_RefreshList, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Rescan"), STAT_UBrowse_Rescan, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Apply Object Changes"), STAT_UBrowse_ApplyChanges, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Sort Live Objects"), STAT_UBrowse_SortLive, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Publish Live Objects"), STAT_UBrowse_Publish, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Customize Details"), STAT_UBrowse_CustomizeDetails, STATGROUP_UBrowse);
+
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SUBrowser::Construct(const FArguments& InArgs)
 {
@@ -52,10 +69,13 @@ void SUBrowser::Construct(const FArguments& InArgs)
 	bOnlyListRootObjects = InArgs._bOnlyListRootObjects;
 	bIncludeTransient = InArgs._bIncludeTransient;
 	bOnlyListGCObjects = InArgs._bOnlyListGCObjects;
+	bParallelScan = InArgs._bParallelScan;
+	MinRefreshInterval = InArgs._MinRefreshInterval;
+	bTimeSlicedScan = InArgs._bTimeSlicedScan;
+	ScanSliceBudget = InArgs._ScanSliceBudget;
 
 	SWidget::SetTag(FName(TEXT("UBrowseTag")));
-	SortBy = EQuerySortMode::ByID;
-	SortDirection = EColumnSortMode::Descending;
+	SortColumns.Add(FUBrowseSortColumn{ EQuerySortMode::ByName, EColumnSortMode::Ascending });
 	FilterClass = UObject::StaticClass();
 
 
@@ -81,6 +101,13 @@ void SUBrowser::Construct(const FArguments& InArgs)
 	PropertyView->RegisterInstancedCustomPropertyLayout(UObject::StaticClass(), UBrowseLiteralDetails);
 
 	// hook into changes
+	ObjectTracker = MakeUnique<FUBrowseObjectTracker>();
+	ObjectTracker->StartTracking();
+	ClassHistogram = MakeShared<FUBrowseClassHistogram>();
+	NameIndex = MakeUnique<FUBrowseNameIndex>();
+	RowTextCache = MakeShared<FUBrowseRowTextCache>();
+	ObjectSizes = MakeShared<FUBrowseObjectSizes>();
+	UpdateSizeTotalText();
 	GEngine->OnLevelActorAdded().AddSP(this, &SUBrowser::OnLevelActorAdded);
 	GEngine->OnLevelActorDeleted().AddSP(this, &SUBrowser::OnLevelActorDeleted);
 	GEngine->OnLevelActorListChanged().AddSP(this, &SUBrowser::OnLevelActorListChanged);
@@ -141,8 +168,9 @@ void SUBrowser::Construct(const FArguments& InArgs)
 					.FillWidth(0.8f)
 					.Padding(5.0f)
 					[
-						SNew(SEditableTextBox)
+						SAssignNew(FilterTextBox, SEditableTextBox)
 						.HintText(LOCTEXT("ObjectName", "Object Name Filter"))
+						.ToolTipText(LOCTEXT("ObjectNameFilterToolTip", "A name to look for, or a query such as\nclass:StaticMeshComponent outer:PersistentLevel flags:+Transient -CDO name~\"Foo.*\"\nTerms: class:, outer:, package:, name: (contains), name= (exact), name~ (regex), flags:+Flag -Flag"))
 						.OnTextCommitted(this, &SUBrowser::OnNewHostTextCommited)
 						.OnTextChanged(this, &SUBrowser::OnNewHostTextCommited, ETextCommit::Default)
 					]
@@ -195,6 +223,58 @@ void SUBrowser::Construct(const FArguments& InArgs)
 							.Text(LOCTEXT("CollectGarbage", "Collect Garbage"))
 						]
 					]
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(5.0f)
+					[
+						SNew(SButton)
+						.OnClicked(this, &SUBrowser::OnCaptureSnapshot)
+						.ToolTipText(LOCTEXT("CaptureSnapshotToolTip", "Write every live object's class, outer, name, flags and size to a snapshot file"))
+						[
+							SNew(STextBlock)
+							.Text(LOCTEXT("CaptureSnapshot", "Capture Snapshot"))
+						]
+					]
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(5.0f)
+					[
+						SNew(SButton)
+						.OnClicked(this, &SUBrowser::OnDiffSnapshots)
+						.ToolTipText(LOCTEXT("DiffSnapshotsToolTip", "Pick two snapshot files and compare their per class and per package totals"))
+						[
+							SNew(STextBlock)
+							.Text(LOCTEXT("DiffSnapshots", "Diff Snapshots..."))
+						]
+					]
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.Padding(5.0f)
+					.VAlign(EVerticalAlignment::VAlign_Center)
+					[
+						SNew(SProgressBar)
+						.Visibility(this, &SUBrowser::GetScanProgressVisibility)
+						.Percent(this, &SUBrowser::GetScanProgress)
+						.ToolTipText(LOCTEXT("ScanProgressToolTip", "Scanning the object array, the list fills in as objects are found"))
+					]
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(5.0f)
+					.VAlign(EVerticalAlignment::VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text(this, &SUBrowser::GetSizeTotalText)
+						.ToolTipText(LOCTEXT("SizeTotalToolTip", "Memory of the listed objects, exclusive (inclusive of subobjects and resources)"))
+					]
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(5.0f)
+					.VAlign(EVerticalAlignment::VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text(this, &SUBrowser::GetScanStatsText)
+						.ToolTipText(LOCTEXT("ScanStatsToolTip", "Last rescan or update of the list: time taken, objects checked against the filter, objects that matched and result buffer allocations. 'stat UBrowse' and Unreal Insights break the time down further"))
+					]
 				]
 				/* The actual list of objects */
 				+ SVerticalBox::Slot()
@@ -204,7 +284,7 @@ void SUBrowser::Construct(const FArguments& InArgs)
 					.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
 					.Padding(FMargin(0.0f, 4.0f))
 					[
-						SAssignNew(ObjectListView, SListView< TSharedPtr<FBrowserObject> >)
+						SAssignNew(ObjectListView, SListView< TWeakObjectPtr<UObject> >)
 						.ItemHeight(24.0f)
 						.ListItemsSource(&(this->GetLiveObjects()))
 						.SelectionMode(ESelectionMode::Single)
@@ -215,7 +295,8 @@ void SUBrowser::Construct(const FArguments& InArgs)
 							SNew(SHeaderRow)
 							+ SHeaderRow::Column("Name")
 							.OnSort(this, &SUBrowser::OnSortByChanged)
-							.SortMode(this, &SUBrowser::GetSortMode)
+							.SortMode(this, &SUBrowser::GetColumnSortMode, FName("Name"))
+							.SortPriority(this, &SUBrowser::GetColumnSortPriority, FName("Name"))
 							.DefaultLabel(LOCTEXT("SUBrowserNameCol", "Name"))
 							.DefaultTooltip(LOCTEXT("SUBrowserNameColTooltip", "Object Name"))
 							.FillWidth(0.2f)
@@ -224,7 +305,8 @@ void SUBrowser::Construct(const FArguments& InArgs)
 							.VAlignCell(VAlign_Center)
 							+ SHeaderRow::Column("Number")
 							.OnSort(this, &SUBrowser::OnSortByChanged)
-							.SortMode(this, &SUBrowser::GetSortMode)
+							.SortMode(this, &SUBrowser::GetColumnSortMode, FName("Number"))
+							.SortPriority(this, &SUBrowser::GetColumnSortPriority, FName("Number"))
 							.DefaultLabel(LOCTEXT("SUBrowserNumberCol", "Number"))
 							.DefaultTooltip(LOCTEXT("SUBrowserNumberColTooltip", "Object Number"))
 							.FillWidth(0.2f)
@@ -233,13 +315,41 @@ void SUBrowser::Construct(const FArguments& InArgs)
 							.VAlignCell(VAlign_Center)
 							+ SHeaderRow::Column("Class")
 							.OnSort(this, &SUBrowser::OnSortByChanged)
-							.SortMode(this, &SUBrowser::GetSortMode)
+							.SortMode(this, &SUBrowser::GetColumnSortMode, FName("Class"))
+							.SortPriority(this, &SUBrowser::GetColumnSortPriority, FName("Class"))
 							.DefaultLabel(LOCTEXT("SUBrowserClassCol", "Class"))
 							.DefaultTooltip(LOCTEXT("SUBrowserClassColTooltip", "Object Class"))
 							.FillWidth(0.2f)
 							.HAlignCell(HAlign_Left)
 							.HAlignHeader(HAlign_Left)
 							.VAlignCell(VAlign_Center)
+							+ SHeaderRow::Column("Id")
+							.OnSort(this, &SUBrowser::OnSortByChanged)
+							.SortMode(this, &SUBrowser::GetColumnSortMode, FName("Id"))
+							.SortPriority(this, &SUBrowser::GetColumnSortPriority, FName("Id"))
+							.DefaultLabel(LOCTEXT("SUBrowserIdCol", "Id"))
+							.DefaultTooltip(LOCTEXT("SUBrowserIdColTooltip", "Object Unique Id"))
+							.FillWidth(0.1f)
+							.HAlignCell(HAlign_Center)
+							.HAlignHeader(HAlign_Center)
+							.VAlignCell(VAlign_Center)
+							+ SHeaderRow::Column("Size")
+							.OnSort(this, &SUBrowser::OnSortByChanged)
+							.SortMode(this, &SUBrowser::GetColumnSortMode, FName("Size"))
+							.SortPriority(this, &SUBrowser::GetColumnSortPriority, FName("Size"))
+							.DefaultLabel(LOCTEXT("SUBrowserSizeCol", "Size"))
+							.DefaultTooltip(LOCTEXT("SUBrowserSizeColTooltip", "Exclusive memory of the object, inclusive in brackets. Sorts by exclusive size"))
+							.FillWidth(0.15f)
+							.HAlignCell(HAlign_Right)
+							.HAlignHeader(HAlign_Right)
+							.VAlignCell(VAlign_Center)
+							+ SHeaderRow::Column("Flags")
+							.DefaultLabel(LOCTEXT("SUBrowserFlagsCol", "Flags"))
+							.DefaultTooltip(LOCTEXT("SUBrowserFlagsColTooltip", "Object flags and internal object flags, the names flags: queries take"))
+							.FillWidth(0.2f)
+							.HAlignCell(HAlign_Left)
+							.HAlignHeader(HAlign_Left)
+							.VAlignCell(VAlign_Center)
 						)
 					]
 				]
@@ -251,7 +361,7 @@ void SUBrowser::Construct(const FArguments& InArgs)
 					.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
 					.Padding(FMargin(0.0f, 4.0f))
 					[
-						SAssignNew(ObjectHistoryView, SListView< TSharedPtr< FBrowserObject > >)
+						SAssignNew(ObjectHistoryView, SListView< TWeakObjectPtr<UObject> >)
 						.ItemHeight(24)
 						.ListItemsSource(&(this->GetCurrentHistoryList()))
 						// Currently, we only need single-selection for this tree
@@ -319,7 +429,7 @@ void SUBrowser::AddBoolFilter(FMenuBuilder& MenuBuilder, FText Text, FText MenuT
 		MenuToolTip,
 		FSlateIcon(),
 		FUIAction(
-			FExecuteAction::CreateLambda([this,BoolOption] { *BoolOption = !(*BoolOption); RefreshList(); }),
+			FExecuteAction::CreateLambda([this,BoolOption] { *BoolOption = !(*BoolOption); RequestRefresh(); }),
 			FCanExecuteAction(),
 			FIsActionChecked::CreateLambda([BoolOption] { return *BoolOption; })
 		),
@@ -328,6 +438,35 @@ void SUBrowser::AddBoolFilter(FMenuBuilder& MenuBuilder, FText Text, FText MenuT
 	);
 }
 
+void SUBrowser::AddScopeFilter(FMenuBuilder& MenuBuilder, FText Text, FText MenuToolTip, bool bPackageScope)
+{
+	MenuBuilder.AddMenuEntry(
+		Text,
+		MenuToolTip,
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateLambda([this, bPackageScope]
+			{
+				const TArray<TWeakObjectPtr<UObject>> Selection = PropertyView->GetSelectedObjects();
+				UObject* ViewedObject = Selection.Num() > 0 ? Selection[0].Get() : nullptr;
+				if (bPackageScope)
+				{
+					FilterPackage = FilterPackage.IsValid() || (ViewedObject == nullptr) ? nullptr : ViewedObject->GetPackage();
+				}
+				else
+				{
+					FilterOuter = FilterOuter.IsValid() ? nullptr : ViewedObject;
+				}
+				RequestRefresh();
+			}),
+			FCanExecuteAction(),
+			FIsActionChecked::CreateLambda([this, bPackageScope] { return bPackageScope ? FilterPackage.IsValid() : FilterOuter.IsValid(); })
+		),
+		NAME_None,
+		EUserInterfaceActionType::ToggleButton
+	);
+}
+
 TSharedRef<SWidget> SUBrowser::MakeFilterMenu()
 {
 	const bool bInShouldCloseWindowAfterMenuSelection = true;
@@ -371,6 +510,40 @@ TSharedRef<SWidget> SUBrowser::MakeFilterMenu()
 		LOCTEXT("IncludeTransientToolTip", "Include objects in transient packages?"),
 		&bIncludeTransient);
 
+	MenuBuilder.EndSection();
+
+	MenuBuilder.BeginSection("Scope", LOCTEXT("ScopeHeading", "Scope"));
+
+	AddScopeFilter(
+		MenuBuilder,
+		LOCTEXT("OnlyInnersOfViewed", "Only Inners Of Viewed Object"),
+		LOCTEXT("OnlyInnersOfViewedToolTip", "Only list objects whose outer is the object shown in the details panel"),
+		false);
+
+	AddScopeFilter(
+		MenuBuilder,
+		LOCTEXT("OnlyInViewedPackage", "Only Objects In Viewed Package"),
+		LOCTEXT("OnlyInViewedPackageToolTip", "Only list objects in the package of the object shown in the details panel"),
+		true);
+
+	MenuBuilder.EndSection();
+
+	MenuBuilder.BeginSection("ScanOptions", LOCTEXT("ScanOptionsHeading", "Scan Options"));
+
+	AddBoolFilter(
+		MenuBuilder,
+		LOCTEXT("ParallelScan", "Parallel Scan"),
+		LOCTEXT("ParallelScanToolTip", "Filter the object array on all cores when rescanning"),
+		&bParallelScan);
+
+	AddBoolFilter(
+		MenuBuilder,
+		LOCTEXT("TimeSlicedScan", "Time Sliced Scan"),
+		LOCTEXT("TimeSlicedScanToolTip", "Spread rescans of the whole object array over several frames, listing objects as they are found"),
+		&bTimeSlicedScan);
+
+	MenuBuilder.EndSection();
+
 	return MenuBuilder.MakeWidget();
 }
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -380,133 +553,536 @@ FUBrowserPanel& SUBrowser::GetCurrentBrowserPanel()
 	return *(BrowserPanels[0]);
 }
 
-const TArray< TSharedPtr<FBrowserObject> >& SUBrowser::GetLiveObjects()
+const TArray< TWeakObjectPtr<UObject> >& SUBrowser::GetLiveObjects()
 {
 	FUBrowserPanel& Panel(GetCurrentBrowserPanel());
-	return Panel.LiveObjects;
+	return Panel.PublishedRows.Handles;
 }
 
 
-const TArray< TSharedPtr<FBrowserObject> >& SUBrowser::GetCurrentHistoryList()
+const TArray< TWeakObjectPtr<UObject> >& SUBrowser::GetCurrentHistoryList()
 {
 	return History;
 }
 
+FUBrowseObjectFilter SUBrowser::MakeFilter() const
+{
+	FUBrowseObjectFilter Filter;
+	Filter.bShouldIncludeClassDefaultObjects = bShouldIncludeClassDefaultObjects;
+	Filter.bShouldIncludeDefaultSubObjects = bShouldIncludeDefaultSubObjects;
+	Filter.bShouldIncludeArchetypeObjects = bShouldIncludeArchetypeObjects;
+	Filter.bOnlyListRootObjects = bOnlyListRootObjects;
+	Filter.bOnlyListGCObjects = bOnlyListGCObjects;
+	Filter.bIncludeTransient = bIncludeTransient;
+	Filter.FilterClass = FilterClass;
+	Filter.FilterString = FilterString;
+	Filter.Query = FilterQuery;
+	Filter.FilterOuter = FilterOuter.Get();
+	Filter.FilterPackage = FilterPackage.Get();
+	return Filter;
+}
+
+FUBrowseQueryIndices SUBrowser::GetQueryIndices() const
+{
+	FUBrowseQueryIndices Indices;
+	Indices.Histogram = ClassHistogram.Get();
+	Indices.NameIndex = NameIndex.Get();
+	return Indices;
+}
+
 void SUBrowser::RefreshList()
 {
-	/*
-		UObject* CheckOuter = nullptr;
-		UPackage* InsidePackage = nullptr;
-	*/
-	FUBrowserPanel& Panel(GetCurrentBrowserPanel());
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_RefreshList);
+
+	const FUBrowseObjectFilter Filter = MakeFilter();
 
-	Panel.LiveObjects.Reset();
+	// also feeds the query planner's estimate of how narrow a class filter is
+	ClassHistogram->Update();
+	// kept current on every refresh so typing a name filter never waits for a rebuild
+	NameIndex->Update();
+
+	LastRefreshTime = FSlateApplication::Get().GetCurrentTime();
+
+	if (ActiveScan.IsValid())
+	{
+		if (Filter == ActiveScan->GetFilter())
+		{
+			// changes made while the scan runs are applied once it completes
+			return;
+		}
+		CancelTimeSlicedScan();
+	}
+
+	// Only a changed filter (or too many changes to replay) needs a full scan, otherwise apply what was created/deleted since the last refresh.
+	// Objects that change in place (renamed, re-flagged, re-outered) are picked up by the next full scan.
+	TArray<int32> CreatedIndices;
+	TArray<int32> DeletedIndices;
+	if (bLiveObjectsValid && (Filter == AppliedFilter) && ObjectTracker->ConsumeChanges(CreatedIndices, DeletedIndices))
+	{
+		if ((CreatedIndices.Num() == 0) && (DeletedIndices.Num() == 0))
+		{
+			// nothing the list shows has changed
+			return;
+		}
+		ApplyObjectChanges(Filter, CreatedIndices, DeletedIndices);
+	}
+	else
+	{
+		RescanLiveObjects(Filter);
+	}
 
-	EObjectFlags ExclusionFlags{ RF_NoFlags };
+	SortLiveObjects();
+	PublishLiveObjects();
+}
 
-	if (!bShouldIncludeDefaultSubObjects)
+void SUBrowser::RequestRefresh()
+{
+	if (!RefreshTimerHandle.IsValid())
 	{
-		ExclusionFlags |= RF_DefaultSubObject;
+		RefreshTimerHandle = RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SUBrowser::OnRefreshTimer));
 	}
+}
 
-	if (!bShouldIncludeArchetypeObjects)
+EActiveTimerReturnType SUBrowser::OnRefreshTimer(double InCurrentTime, float InDeltaTime)
+{
+	if (InCurrentTime - LastRefreshTime < MinRefreshInterval)
 	{
-		ExclusionFlags |= RF_ArchetypeObject;
+		return EActiveTimerReturnType::Continue;
 	}
+	RefreshTimerHandle.Reset();
+	RefreshList();
+	return EActiveTimerReturnType::Stop;
+}
 
-	if (!bShouldIncludeClassDefaultObjects)
+void SUBrowser::RescanLiveObjects(const FUBrowseObjectFilter& Filter)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_Rescan);
+
+	FUBrowserPanel& Panel(GetCurrentBrowserPanel());
+
+	// anything created during the scan is either found by it or replayed afterwards, ListedObjectIndices filters out the overlap
+	ObjectTracker->Reset();
+	Panel.LiveRows.Reset();
+	Panel.bLiveRowsPublished = false;
+	bLiveRowsSorted = false;
+	ListedObjectIndices.Init(false, GUObjectArray.GetObjectArrayNum());
+
+	bLiveObjectsValid = false;
+
+	// only a walk of the whole array is slow enough to be worth spreading over frames, the index lookups are left to run at once
+	if (bTimeSlicedScan && (FUBrowseObjectScanner::PlanQuery(Filter, GetQueryIndices()) == EUBrowseQueryPlan::FullScan))
 	{
-		ExclusionFlags |= RF_ClassDefaultObject;
+		BeginTimeSlicedScan(Filter);
+		return;
 	}
 
-	for (TObjectIterator<UObject> It(ExclusionFlags); It; ++It)
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<UObject*> MatchingObjects;
+	TArray<int32> PendingIndices;
+	FUBrowseScanStats Stats;
+	LastScanPlan = FUBrowseObjectScanner::Query(Filter, bParallelScan ? EUBrowseScanMode::Parallel : EUBrowseScanMode::Serial, GetQueryIndices(), MatchingObjects, &PendingIndices, &Stats);
+	AddScannedObjects(MatchingObjects, PendingIndices);
+	LastScanSeconds = FPlatformTime::Seconds() - StartTime;
+	LastScanStats = Stats;
+	bLastScanIncremental = false;
+
+	AppliedFilter = Filter;
+	bLiveObjectsValid = true;
+}
+
+void SUBrowser::AddScannedObjects(const TArray<UObject*>& MatchingObjects, const TArray<int32>& PendingIndices)
+{
+	FUBrowserPanel& Panel(GetCurrentBrowserPanel());
+
+	// objects still loading are looked at again on the next refresh
+	for (int32 ObjectIndex : PendingIndices)
 	{
+		ObjectTracker->DeferCreated(ObjectIndex);
+	}
 
-		if (bOnlyListGCObjects && GUObjectArray.IsDisregardForGC(*It))
+	FUBrowseObjectRows& LiveRows = Panel.GetLiveRows();
+	LiveRows.Reserve(LiveRows.Num() + MatchingObjects.Num());
+	for (UObject* Object : MatchingObjects)
+	{
+		const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+		if (ObjectIndex >= ListedObjectIndices.Num())
+		{
+			ListedObjectIndices.Add(false, ObjectIndex + 1 - ListedObjectIndices.Num());
+		}
+		else if (ListedObjectIndices[ObjectIndex])
 		{
 			continue;
 		}
+		ListedObjectIndices[ObjectIndex] = true;
+
+		LiveRows.Add(Object);
+		bLiveRowsSorted = false;
+	}
+}
+
+void SUBrowser::BeginTimeSlicedScan(const FUBrowseObjectFilter& Filter)
+{
+	ActiveScan = MakeUnique<FUBrowseTimeSlicedScan>(Filter);
+	if (!ScanTimerHandle.IsValid())
+	{
+		ScanTimerHandle = RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SUBrowser::OnScanTimer));
+	}
+}
+
+void SUBrowser::CancelTimeSlicedScan()
+{
+	if (ScanTimerHandle.IsValid())
+	{
+		UnRegisterActiveTimer(ScanTimerHandle.ToSharedRef());
+		ScanTimerHandle.Reset();
+	}
+	ActiveScan.Reset();
+}
+
+EActiveTimerReturnType SUBrowser::OnScanTimer(double InCurrentTime, float InDeltaTime)
+{
+	// a filter changed mid-scan makes the rest of the scan useless, start over with the new one
+	if (!ActiveScan.IsValid() || (MakeFilter() != ActiveScan->GetFilter()))
+	{
+		ActiveScan.Reset();
+		ScanTimerHandle.Reset();
+		RequestRefresh();
+		return EActiveTimerReturnType::Stop;
+	}
 
-		if (bOnlyListRootObjects && !It->IsRooted())
+	TArray<UObject*> MatchingObjects;
+	TArray<int32> PendingIndices;
+	const bool bComplete = ActiveScan->Step(ScanSliceBudget, MatchingObjects, &PendingIndices);
+	AddScannedObjects(MatchingObjects, PendingIndices);
+
+	if (!bComplete)
+	{
+		// partial results are shown unsorted, sorting millions of rows every slice would eat the budget
+		if (MatchingObjects.Num() > 0)
 		{
-			continue;
+			PublishLiveObjects();
 		}
+		return EActiveTimerReturnType::Continue;
+	}
+
+	AppliedFilter = ActiveScan->GetFilter();
+	bLiveObjectsValid = true;
+	LastScanSeconds = ActiveScan->GetElapsedSeconds();
+	LastScanStats = ActiveScan->GetStats();
+	LastScanPlan = EUBrowseQueryPlan::FullScan;
+	bLastScanIncremental = false;
+	ActiveScan.Reset();
+	ScanTimerHandle.Reset();
+
+	SortLiveObjects();
+	PublishLiveObjects();
+
+	// the scan went past some of the slots touched while it ran, catch up with them
+	if (ObjectTracker->HasChanges())
+	{
+		RequestRefresh();
+	}
+	return EActiveTimerReturnType::Stop;
+}
+
+TOptional<float> SUBrowser::GetScanProgress() const
+{
+	return ActiveScan.IsValid() ? ActiveScan->GetProgress() : 1.0f;
+}
+
+EVisibility SUBrowser::GetScanProgressVisibility() const
+{
+	return ActiveScan.IsValid() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+void SUBrowser::ApplyObjectChanges(const FUBrowseObjectFilter& Filter, const TArray<int32>& CreatedIndices, const TArray<int32>& DeletedIndices)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_ApplyChanges);
+
+	FUBrowserPanel& Panel(GetCurrentBrowserPanel());
+	const double StartTime = FPlatformTime::Seconds();
+	FUBrowseScanStats Stats;
+	Stats.NumVisited = CreatedIndices.Num() + DeletedIndices.Num();
+
+	// deletions first, a slot may have been freed and handed to a new object since the last refresh
+	bool bRemovedAny = false;
+	TMap<TWeakObjectPtr<UObject>, int32> ReusedSlots;
+	for (int32 ObjectIndex : DeletedIndices)
+	{
+		if (ListedObjectIndices.IsValidIndex(ObjectIndex) && ListedObjectIndices[ObjectIndex])
+		{
+			ListedObjectIndices[ObjectIndex] = false;
+			bRemovedAny = true;
 
-		if (!bIncludeTransient)
+			// a scan slice may have listed the object that took the slot after the delete was recorded
+			if (UObject* Occupant = FUBrowseObjectTracker::ResolveObject(ObjectIndex))
+			{
+				ReusedSlots.Add(Occupant, ObjectIndex);
+			}
+		}
+	}
+	if (bRemovedAny)
+	{
+		Panel.GetLiveRows().RemoveStale();
+	}
+	if (ReusedSlots.Num() > 0)
+	{
+		// weak handles compare by serial number, so only a row of the current occupant matches, the old one is gone
+		for (const TWeakObjectPtr<UObject>& Handle : Panel.GetLiveRows().Handles)
 		{
-			UPackage* ContainerPackage = It->GetOutermost();
-			if (ContainerPackage == GetTransientPackage() || ContainerPackage->HasAnyFlags(RF_Transient))
+			if (const int32* ObjectIndex = ReusedSlots.Find(Handle))
 			{
-				continue;
+				ListedObjectIndices[*ObjectIndex] = true;
 			}
 		}
+	}
 
-		if ((FilterClass != nullptr) && (!It->GetClass()->IsChildOf(FilterClass)))
+	for (int32 ObjectIndex : CreatedIndices)
+	{
+		if (ListedObjectIndices.IsValidIndex(ObjectIndex) && ListedObjectIndices[ObjectIndex])
 		{
 			continue;
 		}
 
-
-		if (!FilterString.IsEmpty() && !It->GetName().Contains(FilterString))
+		bool bNotReady = false;
+		UObject* Object = FUBrowseObjectTracker::ResolveObject(ObjectIndex, bNotReady);
+		if (bNotReady)
+		{
+			ObjectTracker->DeferCreated(ObjectIndex);
+			continue;
+		}
+		if ((Object == nullptr) || !Filter.Matches(Object))
 		{
 			continue;
 		}
 
-		TSharedPtr<FBrowserObject> NewObject = MakeShareable(new FBrowserObject(*It));
+		if (ObjectIndex >= ListedObjectIndices.Num())
+		{
+			ListedObjectIndices.Add(false, ObjectIndex + 1 - ListedObjectIndices.Num());
+		}
+		ListedObjectIndices[ObjectIndex] = true;
 
-		Panel.LiveObjects.Add(NewObject);
+		++Stats.NumMatched;
+		Panel.GetLiveRows().Add(Object);
+		bLiveRowsSorted = false;
 	}
 
-	if (SortBy == EQuerySortMode::ByID) {
-		struct FCompareObjectsByName
-		{
-			FORCEINLINE bool operator()(const TSharedPtr< FBrowserObject > A, const TSharedPtr< FBrowserObject > B) const
-			{
-				return GetNameSafe(A->Object.Get()) < GetNameSafe(B->Object.Get());
-			}
-		};
-		Panel.LiveObjects.Sort(FCompareObjectsByName());
+	LastScanSeconds = FPlatformTime::Seconds() - StartTime;
+	LastScanStats = Stats;
+	bLastScanIncremental = true;
+}
+
+void SUBrowser::SortLiveObjects()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_SortLive);
+
+	FUBrowserPanel& Panel(GetCurrentBrowserPanel());
+
+	// keys come from the values the rows captured, the comparisons only look at integers
+	FUBrowseObjectRows& LiveRows = Panel.GetLiveRows();
+	TArray<FUBrowseSortKey> Keys;
+	FUBrowseObjectSorter::BuildKeys(LiveRows, Keys, ObjectSizes.Get());
+	FUBrowseObjectSorter::SortKeys(Keys, SortColumns);
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Keys.Num());
+	for (int32 Row = 0; Row < Keys.Num(); ++Row)
+	{
+		Order[Row] = Keys[Row].Row;
+	}
+	LiveRows.Permute(Order);
+	bLiveRowsSorted = true;
+}
+
+void SUBrowser::PublishLiveObjects()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_Publish);
+
+	FUBrowserPanel& Panel(GetCurrentBrowserPanel());
+	if (Panel.bLiveRowsPublished)
+	{
+		// nothing changed the rows since they were published
+		return;
 	}
-	if (SortBy == EQuerySortMode::ByType)
+
+	// a running scan only appends, copy over the new tail instead of the whole list every slice
+	const int32 NumPublished = Panel.PublishedRows.Num();
+	if (!bPublishedRowsSorted && !bLiveRowsSorted && (NumPublished > 0) && (NumPublished <= Panel.LiveRows.Num())
+		&& (Panel.PublishedRows.Handles.Last() == Panel.LiveRows.Handles[NumPublished - 1]))
 	{
-		struct FCompareObjectsByClass
+		if (NumPublished < Panel.LiveRows.Num())
 		{
-			FORCEINLINE bool operator()(const TSharedPtr< FBrowserObject > A, const TSharedPtr< FBrowserObject > B) const
-			{
-				return GetNameSafe(A->Object->GetClass()) < GetNameSafe(B->Object->GetClass());
-			}
-		};
-		Panel.LiveObjects.Sort(FCompareObjectsByClass());
+			Panel.PublishedRows.Append(Panel.LiveRows, NumPublished);
+			ObjectListView->RequestListRefresh();
+		}
+		return;
 	}
-	if (SortBy == EQuerySortMode::ByNumber)
+
+	// the row at the top of the view stays there whatever was inserted or removed above it
+	const float ScrollOffset = ObjectListView->GetScrollOffset();
+	const int32 AnchorIndex = Panel.PublishedRows.Num() > 0 ? FMath::Clamp(FMath::FloorToInt(ScrollOffset), 0, Panel.PublishedRows.Num() - 1) : INDEX_NONE;
+	const float AnchorFraction = AnchorIndex != INDEX_NONE ? ScrollOffset - float(AnchorIndex) : 0.0f;
+
+	int32 NewAnchorIndex = INDEX_NONE;
+	if (bPublishedRowsSorted && bLiveRowsSorted && (PublishedSortColumns == SortColumns) && FUBrowseObjectSorter::CanCompareRows(SortColumns))
 	{
-		struct FCommpareObjectsByNumber
+		const FUBrowseListDelta Delta = FUBrowseListDelta::Compute(Panel.PublishedRows, Panel.LiveRows, SortColumns, AnchorIndex);
+		if (Delta.IsEmpty())
 		{
-			FORCEINLINE bool operator()(const TSharedPtr< FBrowserObject > A, const TSharedPtr< FBrowserObject > B) const
-			{
-				int32 NumberA = A->Object.Get() ? A->Object.Get()->GetFName().GetNumber() : 0;
-				int32 NumberB = B->Object.Get() ? B->Object.Get()->GetFName().GetNumber() : 0;
-				return NumberA < NumberB;
-			}
-		};
+			return;
+		}
+		NewAnchorIndex = Delta.NewAnchorIndex;
 	}
+	else if (AnchorIndex != INDEX_NONE)
+	{
+		// a different order has no merge to ride along, just look for the same object
+		NewAnchorIndex = Panel.LiveRows.Handles.IndexOfByKey(Panel.PublishedRows.Handles[AnchorIndex]);
+	}
+
+	for (const TWeakObjectPtr<UObject>& Item : ObjectListView->GetSelectedItems())
+	{
+		SelectionToRestore.AddUnique(Item);
+	}
+
+	// rows keep their item, so the list view reuses the widgets of every row that is still there. The live rows
+	// are handed over rather than copied, they are only copied back if a refresh changes them
+	Panel.PublishedRows = MoveTemp(Panel.LiveRows);
+	Panel.LiveRows.Reset();
+	Panel.bLiveRowsPublished = true;
+	bPublishedRowsSorted = bLiveRowsSorted;
+	PublishedSortColumns = SortColumns;
 	ObjectListView->RequestListRefresh();
+
+	if (NewAnchorIndex != INDEX_NONE)
+	{
+		ObjectListView->SetScrollOffset(FMath::Min(NewAnchorIndex, FMath::Max(Panel.PublishedRows.Num() - 1, 0)) + AnchorFraction);
+	}
+
+	// the list view drops selected items that are no longer listed, put back the ones that are listed again.
+	// ListedObjectIndices marks the slots of exactly the published rows now, and a valid handle is its slot's occupant
+	TGuardValue<bool> RestoringSelection(bRestoringSelection, true);
+	for (int32 Index = SelectionToRestore.Num() - 1; Index >= 0; --Index)
+	{
+		const TWeakObjectPtr<UObject> Item = SelectionToRestore[Index];
+		const int32 ObjectIndex = Item.IsValid() ? GUObjectArray.ObjectToIndex(Item.Get()) : INDEX_NONE;
+		if (ObjectIndex == INDEX_NONE)
+		{
+			SelectionToRestore.RemoveAtSwap(Index);
+		}
+		else if (ListedObjectIndices.IsValidIndex(ObjectIndex) && ListedObjectIndices[ObjectIndex])
+		{
+			ObjectListView->SetItemSelection(Item, true, ESelectInfo::Direct);
+			SelectionToRestore.RemoveAtSwap(Index);
+		}
+	}
+
+	// measuring a half scanned list would only be thrown away when the scan publishes the rest, and rows the
+	// size timer only put in order are already being measured
+	if (!ActiveScan.IsValid() && !bResortingBySize)
+	{
+		MeasurePublishedRows();
+	}
+}
+
+void SUBrowser::MeasurePublishedRows()
+{
+	ObjectSizes->BeginPass(GetCurrentBrowserPanel().PublishedRows.Handles);
+	UpdateSizeTotalText();
+	if (!SizeTimerHandle.IsValid())
+	{
+		SizeTimerHandle = RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SUBrowser::OnSizeTimer));
+	}
+}
+
+EActiveTimerReturnType SUBrowser::OnSizeTimer(double InCurrentTime, float InDeltaTime)
+{
+	const bool bPassComplete = ObjectSizes->Step(ScanSliceBudget);
+
+	// rows measured for the first time were sorted as unmeasured, put them in place once a tick rather than waiting for the whole pass
+	const bool bSortedBySize = SortColumns.ContainsByPredicate([](const FUBrowseSortColumn& Column) { return Column.Mode == EQuerySortMode::BySize; });
+	if (bSortedBySize && (ObjectSizes->GetNumMeasuredLastStep() > 0) && bLiveRowsSorted)
+	{
+		TGuardValue<bool> Resorting(bResortingBySize, true);
+		SortLiveObjects();
+		PublishLiveObjects();
+	}
+
+	if (!bPassComplete)
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+	SizeTimerHandle.Reset();
+	UpdateSizeTotalText();
+	return EActiveTimerReturnType::Stop;
+}
+
+void SUBrowser::UpdateSizeTotalText()
+{
+	const FUBrowseSizeTotal& Total = ObjectSizes->GetPassTotal();
+	SizeTotalText = FText::Format(LOCTEXT("SizeTotal", "{0} ({1}) in {2} objects"), FText::AsMemory(Total.Size.Exclusive), FText::AsMemory(Total.Size.Inclusive), FText::AsNumber(Total.NumObjects));
+	if (!ObjectSizes->IsPassComplete())
+	{
+		SizeTotalText = FText::Format(LOCTEXT("SizeTotalMeasuring", "{0}, measuring..."), SizeTotalText);
+	}
+}
+
+FText SUBrowser::GetScanStatsText() const
+{
+	if (ActiveScan.IsValid())
+	{
+		return FText::Format(LOCTEXT("ScanStatsScanning", "Scanning, {0} visited, {1} matched"), FText::AsNumber(ActiveScan->GetStats().NumVisited), FText::AsNumber(ActiveScan->GetStats().NumMatched));
+	}
+
+	FNumberFormattingOptions MillisecondsFormat;
+	MillisecondsFormat.MinimumFractionalDigits = 1;
+	MillisecondsFormat.MaximumFractionalDigits = 1;
+	const FText Milliseconds = FText::AsNumber(LastScanSeconds * 1000.0, &MillisecondsFormat);
+
+	if (bLastScanIncremental)
+	{
+		return FText::Format(LOCTEXT("ScanStatsIncremental", "Update {0} ms, {1} changes, {2} added"), Milliseconds, FText::AsNumber(LastScanStats.NumVisited), FText::AsNumber(LastScanStats.NumMatched));
+	}
+
+	static const FText PlanNames[] =
+	{
+		LOCTEXT("PlanFullScan", "full scan"),
+		LOCTEXT("PlanClassIndex", "class index"),
+		LOCTEXT("PlanOuterIndex", "outer index"),
+		LOCTEXT("PlanPackageIndex", "package index"),
+		LOCTEXT("PlanNameIndex", "name index"),
+	};
+	return FText::Format(LOCTEXT("ScanStats", "Scan ({0}) {1} ms, {2} visited, {3} matched, {4} allocs"), PlanNames[int32(LastScanPlan)], Milliseconds,
+		FText::AsNumber(LastScanStats.NumVisited), FText::AsNumber(LastScanStats.NumMatched), FText::AsNumber(LastScanStats.NumAllocations));
 }
 
 
-void SUBrowser::OnObjectListSelectionChanged(TSharedPtr<FBrowserObject> InItem, ESelectInfo::Type SelectInfo)
+void SUBrowser::OnObjectListSelectionChanged(TWeakObjectPtr<UObject> InItem, ESelectInfo::Type SelectInfo)
 {
+	if (bRestoringSelection)
+	{
+		return;
+	}
+	// a selection made by the user replaces whatever was waiting to be restored
+	SelectionToRestore.Reset();
 	if (!InItem.IsValid())
 	{
 		return;
 	}
 	TArray< TWeakObjectPtr<UObject> > Selection;
-	Selection.Add(InItem->Object);
+	Selection.Add(InItem);
 	AddObjectToHistory(InItem);
 	PropertyView->SetObjects(Selection);
 	OnNewObjectView.Execute(InItem);
 }
 
+void SUBrowser::ShowWhyAlive(UObject* InObject)
+{
+	if (InObject != nullptr)
+	{
+		GetCurrentBrowserPanel().BrowsePanel->ShowWhyAlive(InObject);
+	}
+}
+
 void SUBrowser::ViewUObject(UObject* InObjectToView)
 {
 	if (InObjectToView == nullptr)
@@ -527,11 +1103,10 @@ void SUBrowser::ViewUObject(UObject* InObjectToView)
 	TArray<TWeakObjectPtr<UObject> > Selection;
 	Selection.Add(InObjectToView);
 	auto WeakPtr = TWeakObjectPtr<UObject>(InObjectToView);
-	auto BrowserObject =  MakeShared<FBrowserObject>(WeakPtr);
-	AddObjectToHistory(BrowserObject);
+	AddObjectToHistory(WeakPtr);
 	PropertyView->SetObjects(Selection);
-	RefreshList();
-	OnNewObjectView.Execute(BrowserObject);
+	RequestRefresh();
+	OnNewObjectView.Execute(WeakPtr);
 
 }
 
@@ -564,7 +1139,7 @@ FReply SUBrowser::OnClassSelectionClicked()
 	if (bPressedOk)
 	{
 		FilterClass = ChosenClass;
-		RefreshList();
+		RequestRefresh();
 	}
 
 	return FReply::Handled();
@@ -572,21 +1147,42 @@ FReply SUBrowser::OnClassSelectionClicked()
 
 void SUBrowser::OnNewHostTextCommited(const FText& InText, ETextCommit::Type InCommitType)
 {
-	FilterText = InText;
-	FilterString = FilterText.ToString();
+	// compiled once here, the filter only runs the predicate chain
+	FUBrowseObjectFilter QueryFilter;
+	FText QueryError;
+	const bool bParsed = QueryFilter.SetQueryText(InText.ToString(), QueryError);
+	FilterTextBox->SetError(QueryError);
+	if (!bParsed)
+	{
+		return;
+	}
 
-	RefreshList();
+	FilterString = QueryFilter.FilterString;
+	FilterQuery = QueryFilter.Query;
+	FilterText = FText::FromString(QueryFilter.GetIndexSubstring());
+
+	RequestRefresh();
 }
 
 /** Called when a node is double clicked */
 void SUBrowser::OnNodeDoubleClicked(class UEdGraphNode* Node)
 {
+	UBrowseNode* BrowseNode = Cast<UBrowseNode>(Node);
+	if ((BrowseNode != nullptr) && BrowseNode->IsSummary())
+	{
+		// a summary stands in for many objects, opening it shows the next page of them instead
+		if (UBrowseGraph* BrowseGraph = Cast<UBrowseGraph>(BrowseNode->GetGraph()))
+		{
+			BrowseGraph->ExpandSummary(BrowseNode);
+		}
+		return;
+	}
 	if (Node != nullptr) {
 		TArray< TWeakObjectPtr<UObject> > Selection;
 		const UObject* NodeObject = Cast<UBrowseNode>(Node)->GetUObject();
 		Selection.Add(MakeWeakObjectPtr(const_cast<UObject*>(NodeObject)));
 		PropertyView->SetObjects(Selection);
-		AddObjectToHistory(TSharedPtr<FBrowserObject>(new FBrowserObject(MakeWeakObjectPtr(const_cast<UObject*>(NodeObject)))));
+		AddObjectToHistory(MakeWeakObjectPtr(const_cast<UObject*>(NodeObject)));
 	}
 }
 
@@ -596,30 +1192,110 @@ FReply SUBrowser::OnCollectGarbage()
 	return FReply::Handled();
 }
 
-EColumnSortMode::Type SUBrowser::GetSortMode() const
+FReply SUBrowser::OnCaptureSnapshot()
 {
-	return SortDirection;
+	const FString Filename = FUBrowseSnapshot::GetDefaultDirectory() / FString::Printf(TEXT("Snapshot-%s.%s"), *FDateTime::Now().ToString(), FUBrowseSnapshot::FileExtension);
+
+	FText Error;
+	const bool bCaptured = FUBrowseSnapshot::Capture(Filename, ObjectSizes.Get(), Error);
+
+	FNotificationInfo Info(bCaptured ? FText::Format(LOCTEXT("SnapshotCaptured", "Snapshot saved to {0}"), FText::FromString(Filename)) : Error);
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+	return FReply::Handled();
 }
 
-void SUBrowser::OnSortByChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnName, const EColumnSortMode::Type NewSortMode)
+FReply SUBrowser::OnDiffSnapshots()
 {
-	if (ColumnName == "Class")
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform == nullptr)
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FString> Filenames;
+	const FString FileTypes = FString::Printf(TEXT("UBrowse Snapshot (*.%s)|*.%s"), FUBrowseSnapshot::FileExtension, FUBrowseSnapshot::FileExtension);
+	const bool bPicked = DesktopPlatform->OpenFileDialog(FSlateApplication::Get().FindBestParentWindowHandleForDialogs(AsShared()),
+		LOCTEXT("PickSnapshots", "Pick the two snapshots to compare").ToString(), FUBrowseSnapshot::GetDefaultDirectory(), TEXT(""), FileTypes, EFileDialogFlags::Multiple, Filenames);
+	if (!bPicked || (Filenames.Num() != 2))
 	{
-		SortBy = EQuerySortMode::ByType;
+		return FReply::Handled();
 	}
-	else if (ColumnName == "Name")
+
+	// the older capture is the baseline, going by the time in the headers since files can be renamed or moved.
+	// only the headers are read here, each file is opened once by the diff, which also reports one that cannot be read
+	FUBrowseSnapshot::FHeader FirstHeader;
+	FUBrowseSnapshot::FHeader SecondHeader;
+	FText Error;
+	if (FUBrowseSnapshot::ReadHeader(Filenames[0], FirstHeader, Error) && FUBrowseSnapshot::ReadHeader(Filenames[1], SecondHeader, Error)
+		&& (SecondHeader.CaptureTime < FirstHeader.CaptureTime))
 	{
-		SortBy = EQuerySortMode::ByID;
+		Filenames.Swap(0, 1);
+	}
+
+	SUBrowseSnapshotDiff::OpenWindow(Filenames[0], Filenames[1]);
+	return FReply::Handled();
+}
+
+EQuerySortMode::Type SUBrowser::GetColumnQuerySortMode(FName ColumnName)
+{
+	if (ColumnName == "Class")
+	{
+		return EQuerySortMode::ByType;
 	}
 	else if (ColumnName == "Number")
 	{
-		SortBy = EQuerySortMode::ByNumber;
+		return EQuerySortMode::ByNumber;
 	}
-	RefreshList();
+	else if (ColumnName == "Id")
+	{
+		return EQuerySortMode::ByID;
+	}
+	else if (ColumnName == "Size")
+	{
+		return EQuerySortMode::BySize;
+	}
+	return EQuerySortMode::ByName;
+}
+
+EColumnSortMode::Type SUBrowser::GetColumnSortMode(FName ColumnName) const
+{
+	const EQuerySortMode::Type Mode = GetColumnQuerySortMode(ColumnName);
+	const FUBrowseSortColumn* Column = SortColumns.FindByPredicate([Mode](const FUBrowseSortColumn& Sort) { return Sort.Mode == Mode; });
+	return Column != nullptr ? Column->Direction : EColumnSortMode::None;
+}
+
+EColumnSortPriority::Type SUBrowser::GetColumnSortPriority(FName ColumnName) const
+{
+	const EQuerySortMode::Type Mode = GetColumnQuerySortMode(ColumnName);
+	const int32 Priority = SortColumns.IndexOfByPredicate([Mode](const FUBrowseSortColumn& Sort) { return Sort.Mode == Mode; });
+	return Priority == 1 ? EColumnSortPriority::Secondary : EColumnSortPriority::Primary;
+}
+
+void SUBrowser::OnSortByChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnName, const EColumnSortMode::Type NewSortMode)
+{
+	const FUBrowseSortColumn NewColumn{ GetColumnQuerySortMode(ColumnName), NewSortMode };
+
+	// shift-click adds a secondary column, a plain click starts over with a single column
+	if ((SortPriority == EColumnSortPriority::Secondary) && (SortColumns.Num() > 0) && (SortColumns[0].Mode != NewColumn.Mode))
+	{
+		SortColumns.SetNum(1);
+		SortColumns.Add(NewColumn);
+	}
+	else
+	{
+		SortColumns.Reset();
+		SortColumns.Add(NewColumn);
+	}
+
+	SortLiveObjects();
+	PublishLiveObjects();
 }
 
 void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 {
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_CustomizeDetails);
+
 	struct UBrowseRowBuilder : public TSharedFromThis<UBrowseRowBuilder>
 	{
 		const IDetailsView* View;
@@ -690,26 +1366,24 @@ void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 			auto OnClickedLambda = [Context, FindUBrowserWidget]() -> FReply
 			{
 				TSharedPtr<SUBrowser> UBrowserWidget = FindUBrowserWidget();
-				TSharedPtr<FBrowserObject> SelectedObject(new FBrowserObject);
-				SelectedObject->Object = Context;
-				UBrowserWidget->OnObjectListSelectionChanged(SelectedObject, ESelectInfo::Direct);
+				UBrowserWidget->OnObjectListSelectionChanged(Context, ESelectInfo::Direct);
 				return FReply::Handled();
 			};
 
 			auto OnClickedInstanceLambda = [Context, FindUBrowserWidget]() -> FReply
 			{
 				TSharedPtr<SUBrowser> UBrowserWidget = FindUBrowserWidget();
-				TSharedPtr<FBrowserObject> SelectedObject(new FBrowserObject);
+				TWeakObjectPtr<UObject> SelectedObject;
 				UClass* ContextClass = Cast<UClass>(Context);
 				if ((ContextClass != nullptr) && (ContextClass->GetDefaultObject() != nullptr))
 				{
-					SelectedObject->Object = ContextClass->GetDefaultObject();
+					SelectedObject = ContextClass->GetDefaultObject();
 				}
 				else
 				{
-					SelectedObject->Object = Context;
+					SelectedObject = Context;
 				}			
-				if (SelectedObject->Object != nullptr)
+				if (SelectedObject.IsValid())
 				{
 					UBrowserWidget->OnObjectListSelectionChanged(SelectedObject, ESelectInfo::Direct);
 				}
@@ -719,17 +1393,17 @@ void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 			auto OnClickedClassLambda = [Context, FindUBrowserWidget]() -> FReply
 			{
 				TSharedPtr<SUBrowser> UBrowserWidget = FindUBrowserWidget();
-				TSharedPtr<FBrowserObject> SelectedObject(new FBrowserObject);
+				TWeakObjectPtr<UObject> SelectedObject;
 				UClass* ContextClass = Cast<UClass>(Context);
 				if (ContextClass != nullptr) 
 				{
-					SelectedObject->Object = Context;
+					SelectedObject = Context;
 				}
 				else
 				{
-					SelectedObject->Object = Context->GetClass();
+					SelectedObject = Context->GetClass();
 				}			
-				if (SelectedObject->Object != nullptr)
+				if (SelectedObject.IsValid())
 				{
 					UBrowserWidget->OnObjectListSelectionChanged(SelectedObject, ESelectInfo::Direct);
 				}
@@ -834,6 +1508,38 @@ void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 			];
 		}
 
+		void BuildWhyAliveRow(UObject* Context)
+		{
+			TWeakObjectPtr<UObject> WeakContext(Context);
+			auto OnClickedLambda = [WeakContext]() -> FReply
+			{
+				TSharedPtr<SDockTab> UBrowseTab = FGlobalTabmanager::Get()->TryInvokeTab(FUBrowseModule::UBrowseTabName);
+				TSharedPtr<SUBrowser> UBrowserWidget = StaticCastSharedRef<SUBrowser>(UBrowseTab->GetContent());
+				UBrowserWidget->ShowWhyAlive(WeakContext.Get());
+				return FReply::Handled();
+			};
+
+			Group.AddWidgetRow()
+			.NameContent()
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("GarbageCollectionRow", "Garbage Collection"))
+				.Font(IDetailLayoutBuilder::GetDetailFont())
+			]
+			.ValueContent()
+			.MaxDesiredWidth(0)
+			[
+				SNew(SButton)
+				.OnClicked_Lambda(OnClickedLambda)
+				.ToolTipText(LOCTEXT("WhyAliveToolTip", "Show the shortest chain of references from an object garbage collection keeps to this one"))
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("WhyAlive", "Why Alive?"))
+					.Font(IDetailLayoutBuilder::GetDetailFont())
+				]
+			];
+		}
+
 	};
 
 	struct BoolString
@@ -858,20 +1564,6 @@ void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 		}
 	};
 
-	struct ObjectFlagBuilder
-	{
-
-		static FString PrintObjectFlags(UObject* Object)
-		{
-			if (Object)
-			{
-				FString Buf = LexToString(Object->GetFlags());
-				return Buf;
-			}
-			return TEXT("None");
-		}
-	};
-
 	const IDetailsView*  View = Layout.GetDetailsView();
 	const TArray<TWeakObjectPtr<UObject>> Objects = Layout.GetDetailsView()->GetSelectedObjects();
 	IDetailCategoryBuilder& ObjectCategory = Layout.EditCategory("UObject", FText::GetEmpty(), ECategoryPriority::Variable);
@@ -909,9 +1601,10 @@ void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 			DetailedInfo = PathName;
 		}
 		Builder.BuildSimpleRow(TEXT("Path Name"), TEXT("Path Name"), PathName, DetailedInfo);
-		Builder.BuildSimpleRow(TEXT("Flags"), TEXT("Flags"), ObjectFlagBuilder::PrintObjectFlags(Obj), TEXT("Object Flags"));
+		Builder.BuildSimpleRow(TEXT("Flags"), TEXT("Flags"), FUBrowseObjectFlags::ToString(Obj), TEXT("Object Flags"));
 		FString IsNativeText = BoolProp(Obj->IsNative(), TEXT("Native"));
 		Builder.BuildSimpleRow(TEXT("Native"), TEXT("Native"), IsNativeText, IsNativeText);
+		Builder.BuildWhyAliveRow(Obj);
 		if (Class) {
 			auto ClassName = GetNameSafe(Class);
 			Builder.BuildObjectRow(TEXT("Class"), TEXT("Class"), ClassName, GetFullNameSafe(Class), Class);
@@ -968,10 +1661,8 @@ void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 					UObject* PropertyObject = ObjectProperty->GetObjectPropertyValue(SourceAddr);
 					if (PropertyObject != nullptr)
 					{
-						EObjectFlags ObjectFlags = PropertyObject->GetFlags();
-						FString ObjectFlagsText = LexToString(ObjectFlags);
 						PropertyFlagsText.Append("\n");
-						PropertyFlagsText.Append(ObjectFlagsText);	
+						PropertyFlagsText.Append(FUBrowseObjectFlags::ToString(PropertyObject));
 					}
 					ClassBuilder->BuildObjectRow(CPPType, PropertyName, UnrealValue, PropertyFlagsText, PropertyObject);								
 				}
@@ -1032,31 +1723,32 @@ void FBrowserObject::CustomizeDetails(IDetailLayoutBuilder& Layout)
 	return;
 }
 
-void SUBrowser::AddObjectToHistory(TSharedPtr<FBrowserObject> Item)
+void SUBrowser::AddObjectToHistory(TWeakObjectPtr<UObject> Item)
 {
-	UObject* ItemObject = Item.IsValid() ? Item->Object.Get() : nullptr;
+	UObject* ItemObject = Item.Get();
 	if (ItemObject != nullptr)
 	{
-		if (History.FindByPredicate([ItemObject](TSharedPtr<FBrowserObject> OtherItem)
+		if (History.FindByPredicate([ItemObject](TWeakObjectPtr<UObject> OtherItem)
 		{ 
-			UObject* OtherObject = OtherItem.IsValid() ? OtherItem->Object.Get() : nullptr;
-			return OtherObject == ItemObject;
+			return OtherItem.Get() == ItemObject;
 		}) == nullptr)
 		{
-			History.Add(TSharedPtr<FBrowserObject>(Item));
+			History.Add(Item);
 		}
 	}
 	ObjectHistoryView->RequestListRefresh();
 }
 
-TSharedRef<ITableRow> SUBrowser::OnGenerateObjectListRow(TSharedPtr<FBrowserObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SUBrowser::OnGenerateObjectListRow(TWeakObjectPtr<UObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	return SNew(SUBrowserTableRow, OwnerTable)
 		.Object(ObjectPtr)
-		.HighlightText(FilterText);
+		.HighlightText(FilterText)
+		.TextCache(RowTextCache)
+		.ObjectSizes(ObjectSizes);
 }
 
-TSharedRef<ITableRow> SUBrowser::HandlePropertyGenerateRow(TSharedPtr<FBrowserObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SUBrowser::HandlePropertyGenerateRow(TWeakObjectPtr<UObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	return SNew(SUBrowsePropertyTableRow, OwnerTable)
 		.Object(ObjectPtr)
@@ -1065,15 +1757,15 @@ TSharedRef<ITableRow> SUBrowser::HandlePropertyGenerateRow(TSharedPtr<FBrowserOb
 
 
 /** @return A widget to represent a data item in the TreeView */
-TSharedRef<ITableRow> SUBrowser::OnGenerateHistoryRow(TSharedPtr<FBrowserObject> InItem, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SUBrowser::OnGenerateHistoryRow(TWeakObjectPtr<UObject> InItem, const TSharedRef<STableViewBase>& OwnerTable)
 {
-	return SNew(SUBrowserTableRow, OwnerTable).Object(InItem);
+	return SNew(SUBrowserTableRow, OwnerTable).Object(InItem).TextCache(RowTextCache);
 }
 
-void SUBrowser::OnHistorySelectionChanged(TSharedPtr<FBrowserObject> InItem, ESelectInfo::Type /*SelectInfo*/)
+void SUBrowser::OnHistorySelectionChanged(TWeakObjectPtr<UObject> InItem, ESelectInfo::Type /*SelectInfo*/)
 {
 	TArray< TWeakObjectPtr<UObject> > Selection;
-	UObject* HistoryObject = InItem->Object.Get();
+	UObject* HistoryObject = InItem.Get();
 	Selection.Add(MakeWeakObjectPtr(HistoryObject));
 	PropertyView->SetObjects(Selection);
 	OnNewObjectView.Execute(InItem);
@@ -1082,7 +1774,7 @@ void SUBrowser::OnHistorySelectionChanged(TSharedPtr<FBrowserObject> InItem, ESe
 void SUBrowser::PopulateHistoryList()
 {
 	History.Empty();
-	TSharedPtr< FBrowserObject >  InitialObject(new FBrowserObject(UObject::StaticClass()));
+	TWeakObjectPtr<UObject> InitialObject(UObject::StaticClass());
 	History.Add(InitialObject);
 	OnNewObjectView.Execute(InitialObject);
 }
@@ -1090,7 +1782,7 @@ void SUBrowser::PopulateHistoryList()
 
 void SUBrowser::OnLevelActorAdded(AActor* InActor)
 {
-	RefreshList();
+	RequestRefresh();
 }
 	
 void SUBrowser::OnLevelActorDeleted(AActor* InActor)
@@ -1108,21 +1800,22 @@ void SUBrowser::OnLevelActorDeleted(AActor* InActor)
 			}
 		}
 	}
-	RefreshList();
+	RequestRefresh();
 }
 
 void SUBrowser::OnLevelActorListChanged()
 {
-	RefreshList();
+	RequestRefresh();
 }
 
 void SUBrowser::OnPostGarbageCollect()
 {
 	PropertyView->RemoveInvalidObjects();
+	ObjectSizes->RemoveStale();
 	if (PropertyView->GetSelectedObjects().Num() == 0)
 	{
 		ViewUObject(UObject::StaticClass());
 	}
-	RefreshList();
+	RequestRefresh();
 }
 #undef LOCTEXT_NAMESPACE
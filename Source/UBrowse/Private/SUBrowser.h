@@ -5,6 +5,17 @@
 #include "IDetailsView.h"
 #include "SUBrowsePanel.h"
 #include "UBrowse.h"
+#include "UBrowseClassHistogram.h"
+#include "UBrowseListDelta.h"
+#include "UBrowseNameIndex.h"
+#include "UBrowseObjectFilter.h"
+#include "UBrowseObjectRows.h"
+#include "UBrowseObjectScanner.h"
+#include "UBrowseObjectSizes.h"
+#include "UBrowseObjectSort.h"
+#include "UBrowseObjectTracker.h"
+#include "UBrowseRowTextCache.h"
+#include "UBrowseSnapshot.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/SWidget.h"
@@ -12,21 +23,28 @@
 #include "Widgets/Views/SListView.h"
 
 class IDetailsView;
-
-namespace EQuerySortMode
-{
-enum Type
-{
-    ByID,
-    ByType,
-    ByNumber
-};
-}
+class SEditableTextBox;
 
 struct FUBrowserPanel
 {
-    TArray<TSharedPtr<FBrowserObject> > LiveObjects;
+    /* Rows being built by refreshes and scans, moved into PublishedRows when published, go through GetLiveRows */
+    FUBrowseObjectRows LiveRows;
+    /* Rows the list view shows, only replaced when LiveRows differs */
+    FUBrowseObjectRows PublishedRows;
+    /* True while the live rows are the published ones, LiveRows itself is empty then */
+    bool bLiveRowsPublished = false;
     TSharedPtr<SUBrowsePanel> BrowsePanel;
+
+    /** The live rows, copied back from the published ones the first time they change after a publish */
+    FUBrowseObjectRows& GetLiveRows()
+    {
+        if (bLiveRowsPublished)
+        {
+            LiveRows = PublishedRows;
+            bLiveRowsPublished = false;
+        }
+        return LiveRows;
+    }
 };
 
 class SUBrowser : public SCompoundWidget
@@ -34,13 +52,24 @@ class SUBrowser : public SCompoundWidget
     friend FBrowserObject;
 
   public:
-    SLATE_BEGIN_ARGS(SUBrowser) {}
+    SLATE_BEGIN_ARGS(SUBrowser)
+        : _MinRefreshInterval(0.1f)
+        , _bTimeSlicedScan(false)
+        , _ScanSliceBudget(0.008f)
+    {}
     SLATE_ARGUMENT(bool, bShouldIncludeClassDefaultObjects)
     SLATE_ARGUMENT(bool, bShouldIncludeDefaultSubObjects)
     SLATE_ARGUMENT(bool, bShouldIncludeArchetypeObjects)
     SLATE_ARGUMENT(bool, bOnlyListRootObjects)
     SLATE_ARGUMENT(bool, bOnlyListGCObjects)
     SLATE_ARGUMENT(bool, bIncludeTransient)
+    SLATE_ARGUMENT(bool, bParallelScan)
+    /* Shortest time in seconds between two scheduled refreshes of the object list */
+    SLATE_ARGUMENT(float, MinRefreshInterval)
+    /* Spread full rescans over several frames instead of blocking until they finish */
+    SLATE_ARGUMENT(bool, bTimeSlicedScan)
+    /* Seconds of each frame a time sliced scan may use */
+    SLATE_ARGUMENT(float, ScanSliceBudget)
     SLATE_END_ARGS()
 
     /**
@@ -52,10 +81,16 @@ class SUBrowser : public SCompoundWidget
 
     void RefreshList();
 
+    /* Mark the object list dirty, it is refreshed once on a later frame however many requests arrive before then */
+    void RequestRefresh();
+
     void ViewUObject(UObject* InObjectToView);
 
+    /* Show the chain of references keeping an object from being garbage collected in the graph */
+    void ShowWhyAlive(UObject* InObject);
+
   private:
-    DECLARE_DELEGATE_OneParam(FOnNewObjectView, TSharedPtr<FBrowserObject>);
+    DECLARE_DELEGATE_OneParam(FOnNewObjectView, TWeakObjectPtr<UObject>);
 
     FOnNewObjectView OnNewObjectView;
 
@@ -65,16 +100,64 @@ class SUBrowser : public SCompoundWidget
     bool bOnlyListRootObjects;
     bool bOnlyListGCObjects;
     bool bIncludeTransient;
+    bool bParallelScan;
+    bool bTimeSlicedScan;
+
+    /** Snapshot of the current filter options */
+    FUBrowseObjectFilter MakeFilter() const;
+
+    FUBrowseQueryIndices GetQueryIndices() const;
+
+    /** Rebuild the live object list from scratch with a full scan */
+    void RescanLiveObjects(const FUBrowseObjectFilter& Filter);
+
+    /** Bring the live object list up to date with the objects created/deleted since the last refresh */
+    void ApplyObjectChanges(const FUBrowseObjectFilter& Filter, const TArray<int32>& CreatedIndices, const TArray<int32>& DeletedIndices);
+
+    /** Add scanned objects to the live object list, objects still loading are left for a later refresh */
+    void AddScannedObjects(const TArray<UObject*>& MatchingObjects, const TArray<int32>& PendingIndices);
+
+    void SortLiveObjects();
+
+    /** Show the live rows in the list view if they differ from what it shows, keeping its selection and the row at the top */
+    void PublishLiveObjects();
 
-    void OnObjectListSelectionChanged(TSharedPtr<FBrowserObject> InItem, ESelectInfo::Type SelectInfo);
+    /** Start a full scan that runs a slice per frame and streams its results into the list */
+    void BeginTimeSlicedScan(const FUBrowseObjectFilter& Filter);
+
+    /** Drop the running time sliced scan, leaving whatever it listed so far */
+    void CancelTimeSlicedScan();
+
+    EActiveTimerReturnType OnScanTimer(double InCurrentTime, float InDeltaTime);
+
+    TOptional<float> GetScanProgress() const;
+
+    EVisibility GetScanProgressVisibility() const;
+
+    /** Start measuring the published rows, sizes already known are reused */
+    void MeasurePublishedRows();
+
+    EActiveTimerReturnType OnSizeTimer(double InCurrentTime, float InDeltaTime);
+
+    /** Format the size totals into SizeTotalText, called when a pass starts or completes */
+    void UpdateSizeTotalText();
+
+    FText GetSizeTotalText() const { return SizeTotalText; }
+
+    /** Time and counts of the last rescan or replay of changes */
+    FText GetScanStatsText() const;
+
+    EActiveTimerReturnType OnRefreshTimer(double InCurrentTime, float InDeltaTime);
+
+    void OnObjectListSelectionChanged(TWeakObjectPtr<UObject> InItem, ESelectInfo::Type SelectInfo);
 
     void OnNewHostTextCommited(const FText& InText, ETextCommit::Type InCommitType);
 
     TSharedRef<ITableRow> OnGenerateObjectListRow(
-        TSharedPtr<FBrowserObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable);
+        TWeakObjectPtr<UObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable);
 
     TSharedRef<ITableRow> HandlePropertyGenerateRow(
-        TSharedPtr<FBrowserObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable);
+        TWeakObjectPtr<UObject> ObjectPtr, const TSharedRef<STableViewBase>& OwnerTable);
 
     FText GetFilterClassText() const;
 
@@ -82,34 +165,45 @@ class SUBrowser : public SCompoundWidget
 
     FReply OnCollectGarbage();
 
+    FReply OnCaptureSnapshot();
+
+    FReply OnDiffSnapshots();
+
     void AddBoolFilter(FMenuBuilder& MenuBuilder, FText Text, FText ToolTip, bool* BoolOption);
 
+    /* Toggle limiting the list to the inners/package of the object currently shown in the details view */
+    void AddScopeFilter(FMenuBuilder& MenuBuilder, FText Text, FText ToolTip, bool bPackageScope);
+
     TSharedRef<SWidget> MakeFilterMenu();
 
     void OnNodeDoubleClicked(class UEdGraphNode* Node);
 
     void OnGetChildrenForTree(TWeakObjectPtr<UObject> InClass, TArray<TWeakObjectPtr<UObject> >& OutChildren);
 
-    TSharedRef<ITableRow> OnGenerateHistoryRow(TSharedPtr<FBrowserObject> InItem, const TSharedRef<STableViewBase>& OwnerTable);
+    TSharedRef<ITableRow> OnGenerateHistoryRow(TWeakObjectPtr<UObject> InItem, const TSharedRef<STableViewBase>& OwnerTable);
 
-    void OnHistorySelectionChanged(TSharedPtr<FBrowserObject> InItem, ESelectInfo::Type /*SelectInfo*/);
+    void OnHistorySelectionChanged(TWeakObjectPtr<UObject> InItem, ESelectInfo::Type /*SelectInfo*/);
 
     void OnSortByChanged(
         const EColumnSortPriority::Type SortPriority, const FName& ColumnName, const EColumnSortMode::Type NewSortMode);
 
-    EColumnSortMode::Type GetSortMode() const;
+    EColumnSortMode::Type GetColumnSortMode(FName ColumnName) const;
+
+    EColumnSortPriority::Type GetColumnSortPriority(FName ColumnName) const;
+
+    static EQuerySortMode::Type GetColumnQuerySortMode(FName ColumnName);
 
     TSharedPtr<SWidget> GetTreeContextMenu();
 
-    void AddObjectToHistory(TSharedPtr<FBrowserObject> Item);
+    void AddObjectToHistory(TWeakObjectPtr<UObject> Item);
 
     void PopulateHistoryList();
 
     FUBrowserPanel& GetCurrentBrowserPanel();
 
-    const TArray<TSharedPtr<FBrowserObject> >& GetLiveObjects();
+    const TArray<TWeakObjectPtr<UObject> >& GetLiveObjects();
 
-    const TArray<TSharedPtr<FBrowserObject> >& GetCurrentHistoryList();
+    const TArray<TWeakObjectPtr<UObject> >& GetCurrentHistoryList();
 
     void OnLevelActorAdded(AActor* InActor);
     void OnLevelActorDeleted(AActor* InActor);
@@ -119,16 +213,92 @@ class SUBrowser : public SCompoundWidget
     // Filters
     FText FilterText;
     FString FilterString;
+    TSharedPtr<const FUBrowseQuery> FilterQuery;
     UClass* FilterClass;
-  
+    TWeakObjectPtr<UObject> FilterOuter;
+    TWeakObjectPtr<UPackage> FilterPackage;
+
+    /* Filter the live object list was last built with */
+    FUBrowseObjectFilter AppliedFilter;
+
+    /* True once a full scan has populated the live object list */
+    bool bLiveObjectsValid = false;
+
+    /* GUObjectArray slots currently in the live object list */
+    TBitArray<> ListedObjectIndices;
+
+    /* True while LiveRows is in SortColumns order, scans and replayed changes append unsorted */
+    bool bLiveRowsSorted = false;
+
+    /* Sortedness and columns of the published rows, a delta against them is only meaningful when both lists agree */
+    bool bPublishedRowsSorted = false;
+    TArray<FUBrowseSortColumn> PublishedSortColumns;
+
+    /* Selected objects that dropped out of the published rows, e.g. during a rescan, selected again once they are back */
+    TArray<TWeakObjectPtr<UObject> > SelectionToRestore;
+
+    /* Set while PublishLiveObjects selects rows, so doing so does not count as the user browsing to them */
+    bool bRestoringSelection = false;
+
+    /* Objects created/deleted since the last refresh */
+    TUniquePtr<FUBrowseObjectTracker> ObjectTracker;
+
+    /* Pending scheduled refresh, valid while the object list is dirty */
+    TSharedPtr<FActiveTimerHandle> RefreshTimerHandle;
+
+    /* Shortest time between two scheduled refreshes */
+    float MinRefreshInterval = 0.1f;
+
+    /* Slate time of the last refresh */
+    double LastRefreshTime = 0.0;
+
+    /* Full scan currently being spread over frames, if any */
+    TUniquePtr<FUBrowseTimeSlicedScan> ActiveScan;
+
+    /* Ticks ActiveScan */
+    TSharedPtr<FActiveTimerHandle> ScanTimerHandle;
+
+    /* Seconds of each frame ActiveScan may use */
+    float ScanSliceBudget = 0.008f;
+
+    /* What the last rescan or replay of changes looked at and how long it took, summed over the slices of a time sliced scan */
+    FUBrowseScanStats LastScanStats;
+    double LastScanSeconds = 0.0;
+    EUBrowseQueryPlan LastScanPlan = EUBrowseQueryPlan::FullScan;
+    bool bLastScanIncremental = false;
+
+    /* Live instance counts per class, read by the class rows */
+    TSharedPtr<FUBrowseClassHistogram> ClassHistogram;
+
+    /* Substring index over object names, answers the name filter without a scan */
+    TUniquePtr<FUBrowseNameIndex> NameIndex;
+
+    /* Memory sizes of the listed objects, filled in over frames after each publish */
+    TSharedPtr<FUBrowseObjectSizes> ObjectSizes;
+
+    /* Ticks ObjectSizes while a pass is running */
+    TSharedPtr<FActiveTimerHandle> SizeTimerHandle;
+
+    /* Set while the size timer republishes rows it sorted, the pass running over them goes on rather than starting over */
+    bool bResortingBySize = false;
+
+    /* Shown under the list, only changes with the size totals so it is formatted then rather than every frame */
+    FText SizeTotalText;
+
+    /* Formatted row text, outlives the row widgets so refreshes and scrolling reuse it */
+    TSharedPtr<FUBrowseRowTextCache> RowTextCache;
+
+    /* Name/query box, shows parse errors */
+    TSharedPtr<SEditableTextBox> FilterTextBox;
+
     // Holds the widget switcher.
     TSharedPtr<SWidgetSwitcher> UBrowseSwitcher;
 
     /* List of objects of selectable class - used to zoom in on what's intersting */
-    TSharedPtr<SListView<TSharedPtr<FBrowserObject> > > ObjectListView;
+    TSharedPtr<SListView<TWeakObjectPtr<UObject> > > ObjectListView;
 
     /* List of objects we have browsed */
-    TSharedPtr<SListView<TSharedPtr<FBrowserObject> > > ObjectHistoryView;
+    TSharedPtr<SListView<TWeakObjectPtr<UObject> > > ObjectHistoryView;
 
     /* Customized detail view we use for examining properties */
     TSharedPtr<IDetailsView> PropertyView;
@@ -137,11 +307,8 @@ class SUBrowser : public SCompoundWidget
     TArray<TSharedPtr<FUBrowserPanel> > BrowserPanels;
 
     /* History of objects browsed */
-    TArray<TSharedPtr<FBrowserObject> > History;
-
-    /** Current way we are sorting queries */
-    EQuerySortMode::Type SortBy;
+    TArray<TWeakObjectPtr<UObject> > History;
 
-    /** Current way we are setting ID sort direction */
-    EColumnSortMode::Type SortDirection;
+    /** Columns we are sorting queries by, primary first */
+    TArray<FUBrowseSortColumn> SortColumns;
 };
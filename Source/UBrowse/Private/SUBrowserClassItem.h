@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ClassIconFinder.h"
+#include "UBrowseClassHistogram.h"
 
 #define LOCTEXT_NAMESPACE "SUBrowserClassItem"
 
@@ -12,6 +13,7 @@ public:
         : _ClassToView()
         {}
         SLATE_ARGUMENT( TWeakObjectPtr< UObject >, ClassToView )
+        SLATE_ARGUMENT( TSharedPtr< FUBrowseClassHistogram >, ClassHistogram )
     SLATE_END_ARGS()
 
 	BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -67,6 +69,7 @@ public:
     void Construct( const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView )
 	{
 		ClassToView = InArgs._ClassToView;
+		ClassHistogram = InArgs._ClassHistogram;
 
 		SMultiColumnTableRow< TWeakObjectPtr<UObject> >::Construct(FSuperRowType::FArguments(), InOwnerTableView);
     }
@@ -79,17 +82,18 @@ private:
 
 	FText OnCalcCount() const
 	{
-		uint32_t InstanceCount = 0;
-		for (FThreadSafeObjectIterator Itr; Itr; ++Itr) {
-			if (Itr->IsA(Cast<UClass>(ClassToView.Get())))
-				InstanceCount++;
-		}
-		return FText::FromString(FString::FromInt(InstanceCount));
+		// counts are maintained by the histogram, the row only reads them
+		const UClass* Class = Cast<UClass>(ClassToView.Get());
+		const int32 InstanceCount = (ClassHistogram.IsValid() && Class != nullptr) ? ClassHistogram->GetInclusiveCount(Class) : 0;
+		return FText::AsNumber(InstanceCount);
 	}
 
    	/** A pointer to the data item that we visualize/edit */
 	TWeakObjectPtr< UObject > ClassToView;
 
+	/** Shared instance counts for every class */
+	TSharedPtr< FUBrowseClassHistogram > ClassHistogram;
+
 };
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
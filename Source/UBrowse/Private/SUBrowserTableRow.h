@@ -3,6 +3,9 @@
 #pragma once
 
 #include "UBrowse.h"
+#include "UBrowseObjectFlags.h"
+#include "UBrowseObjectSizes.h"
+#include "UBrowseRowTextCache.h"
 #include "ClassIconFinder.h"
 #include "SlateOptMacros.h"
 #include "Widgets/Views/STableRow.h"
@@ -21,17 +24,16 @@ class SUBrowserTableRow
 public:
 
 	SLATE_BEGIN_ARGS(SUBrowserTableRow) { }
-		SLATE_ARGUMENT(TSharedPtr<FBrowserObject>, Object)
+		SLATE_ARGUMENT(TWeakObjectPtr<UObject>, Object)
 		SLATE_ARGUMENT(FText, HighlightText)
+		/* Shared formatted text, a private one is made if none is given */
+		SLATE_ARGUMENT(TSharedPtr<FUBrowseRowTextCache>, TextCache)
+		/* Measured sizes for the Size column, which stays blank without them */
+		SLATE_ARGUMENT(TSharedPtr<FUBrowseObjectSizes>, ObjectSizes)
 	SLATE_END_ARGS()
 
 public:
 
-	SUBrowserTableRow()
-		: ClassIcon(nullptr)
-	{
-	}
-
 	/**
 	* Constructs the widget.
 	*
@@ -39,21 +41,11 @@ public:
 	*/
 	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
 	{
+		// text is only formatted by the columns that are actually generated
 		Object = InArgs._Object;
-
-		if (UObject* Obj = InArgs._Object->Object.Get())
-		{
-			Name = FText::FromString(Obj ? Obj->GetFName().ToString() : FString("None"));
-			ClassName = Obj->GetClass()->GetDisplayNameText();
-			Package = FText::FromString(Obj->GetFullName());
-			HighlightText = InArgs._HighlightText;
-			OuterName = Obj->GetOuter() != nullptr ? FText::FromString(Obj->GetOuter()->GetName()) : LOCTEXT("NoOuter", "None");			
-			// Get selection icon based on actor(s) classes and add before the selection label
-			FSlateIcon Icon(FSlateIconFinder::FindIconForClass(Obj->GetClass()));
-			ClassIcon = Icon.GetSmallIcon();
-			Number = Obj ? Obj->GetFName().GetNumber() : 0;
-			Id = Obj ? Obj->GetUniqueID() : 0;
-		}	
+		HighlightText = InArgs._HighlightText;
+		TextCache = InArgs._TextCache.IsValid() ? InArgs._TextCache : MakeShared<FUBrowseRowTextCache>(1);
+		ObjectSizes = InArgs._ObjectSizes;
 
 		SMultiColumnTableRow<TSharedPtr<int32> >::Construct(FSuperRowType::FArguments(), InOwnerTableView);
 	}
@@ -70,40 +62,55 @@ public:
 					.AutoWidth()
 					[
 						SNew(SImage)
-						.Image(ClassIcon)
+						.Image(TextCache->GetClassIcon(Object))
 					]
 					+ SHorizontalBox::Slot()
 					.AutoWidth()
 					[
 						SNew(STextBlock)
-						.Text(ClassName)
+						.Text(TextCache->GetClassName(Object))
 					];
 		}
 		else if (ColumnName == "Name")
 		{
 			return SNew(STextBlock)
-					.Text(Name)
+					.Text(TextCache->GetName(Object))
 					.HighlightText(HighlightText);
 		}
 		else if (ColumnName == "Path")
 		{
 			return SNew(STextBlock)
-				   .Text(Package);
+				   .Text(TextCache->GetPath(Object));
 		}
 		else if (ColumnName == "Outer")
 		{
 			return SNew(STextBlock)
-				   .Text(OuterName);
+				   .Text(TextCache->GetOuterName(Object));
 		} 
 		else if (ColumnName == "Number")
 		{
 			return SNew(STextBlock)
-				   .Text(FText::AsNumber(Number));
+				   .Text(TextCache->GetNumber(Object));
 		}
 		else if (ColumnName == "Id")
 		{
 			return SNew(STextBlock)
-				   .Text(FText::AsNumber(Id));
+				   .Text(TextCache->GetId(Object));
+		}
+		else if (ColumnName == "Flags")
+		{
+			// flags change as objects load and get destroyed, so they are read at generation rather than cached with the row text
+			const UObject* RowObject = Object.Get();
+			return SNew(STextBlock)
+				   .Text(FUBrowseObjectFlags::GetText(RowObject))
+				   .ToolTipText(FUBrowseObjectFlags::GetText(RowObject));
+		}
+		else if (ColumnName == "Size")
+		{
+			// the size may still be on its way, so the text is polled until it shows up
+			return SNew(STextBlock)
+				   .Text(this, &SUBrowserTableRow::GetSizeText)
+				   .ToolTipText(this, &SUBrowserTableRow::GetSizeToolTipText);
 		}
 
 		return SNullWidget::NullWidget;
@@ -112,18 +119,40 @@ public:
 
 private:
 
-	TSharedPtr<FBrowserObject> Object;
+	FText GetSizeText() const
+	{
+		if (SizeText.IsEmpty() && ObjectSizes.IsValid())
+		{
+			if (const FUBrowseObjectSize* Size = ObjectSizes->Find(Object))
+			{
+				SizeText = FText::Format(LOCTEXT("SizeText", "{0} ({1})"), FText::AsMemory(Size->Exclusive), FText::AsMemory(Size->Inclusive));
+			}
+		}
+		return SizeText;
+	}
+
+	FText GetSizeToolTipText() const
+	{
+		const UObject* RowObject = Object.Get();
+		const FUBrowseSizeTotal* ClassTotal = (RowObject != nullptr && ObjectSizes.IsValid()) ? ObjectSizes->FindClassTotal(RowObject->GetClass()) : nullptr;
+		if (ClassTotal == nullptr)
+		{
+			return FText::GetEmpty();
+		}
+		return FText::Format(LOCTEXT("ClassSizeToolTip", "All listed {0}: {1} ({2} inclusive) in {3} objects"),
+			FText::FromName(RowObject->GetClass()->GetFName()), FText::AsMemory(ClassTotal->Size.Exclusive), FText::AsMemory(ClassTotal->Size.Inclusive), FText::AsNumber(ClassTotal->NumObjects));
+	}
+
+	TWeakObjectPtr<UObject> Object;
+
+	TSharedPtr<FUBrowseObjectSizes> ObjectSizes;
+
+	/* Formatted once the size is known */
+	mutable FText SizeText;
 
-	const FSlateBrush* ClassIcon;
+	TSharedPtr<FUBrowseRowTextCache> TextCache;
 
-	// Holds the transaction's title text.
-	FText Name;
-	FText ClassName;
-	FText Package;
-	FText OuterName;
 	FText HighlightText;
-	int32 Number;
-	int32 Id;
 };
 
 
@@ -0,0 +1,53 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "UBrowseBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Times the object list pipeline over a million synthetic objects and fails for every stage over its limit.
+ * The limits can be overridden with -UBrowsePerfThresholds=File.json and the runs per stage set with
+ * -UBrowsePerfIterations=N, the report goes to Saved/UBrowse/Benchmark.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUBrowsePerfPipelineTest, "UBrowse.Perf.Pipeline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FUBrowsePerfPipelineTest::RunTest(const FString& Parameters)
+{
+	int32 Iterations = 5;
+	FString ThresholdsFile;
+	FParse::Value(FCommandLine::Get(), TEXT("UBrowsePerfIterations="), Iterations);
+	FParse::Value(FCommandLine::Get(), TEXT("UBrowsePerfThresholds="), ThresholdsFile);
+
+	FUBrowseBenchmark Benchmark(FUBrowseBenchmark::DefaultNumObjects, Iterations, ThresholdsFile);
+	FString Error;
+	if (!Benchmark.Run(Error))
+	{
+		AddError(Error);
+		return false;
+	}
+	for (const FUBrowseBenchmarkStage& Stage : Benchmark.GetStages())
+	{
+		if (Stage.Passed())
+		{
+			AddInfo(FString::Printf(TEXT("%s %.3fs per million"), *Stage.Stage, Stage.GetSecondsPerMillion()));
+		}
+		else
+		{
+			AddError(Stage.GetFailure());
+		}
+	}
+
+	const FString ReportFile = FUBrowseBenchmark::GetDefaultReportFile();
+	if (!Benchmark.WriteReport(ReportFile))
+	{
+		AddError(FString::Printf(TEXT("Could not write %s"), *ReportFile));
+	}
+	else
+	{
+		AddInfo(FString::Printf(TEXT("Wrote %s"), *ReportFile));
+	}
+	return !HasAnyErrors();
+}
+
+#endif
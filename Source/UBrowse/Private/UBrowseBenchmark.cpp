@@ -0,0 +1,372 @@
+#include "UBrowseBenchmark.h"
+#include "Algo/AllOf.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "Curves/CurveVector.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Math/RandomStream.h"
+#include "UBrowseClassHistogram.h"
+#include "UBrowseGraphLayout.h"
+#include "UBrowseListDelta.h"
+#include "UBrowseNameIndex.h"
+#include "UBrowseObjectFilter.h"
+#include "UBrowseObjectRows.h"
+#include "UBrowseObjectScanner.h"
+#include "UBrowseObjectSort.h"
+#include "UBrowseRowTextCache.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUBrowseBenchmark, Log, All);
+
+namespace
+{
+	/* Every synthetic object gets this in its name, the name filter stage looks for one of them */
+	const TCHAR* SyntheticNamePrefix = TEXT("UBrowseBench");
+
+	/* Objects per synthetic outer, later ones nest inside earlier ones */
+	constexpr int32 ObjectsPerOuter = 64;
+
+	/* Rows formatted by the row generation stage, about what a tall list view shows while scrolling */
+	constexpr int32 RowsToFormat = 100 * 1000;
+
+	/* Nodes of the synthetic graph laid out by the graph layout stage, a large reference graph */
+	constexpr int32 GraphLayoutNodes = 600;
+
+	/* Default limit per stage in seconds per million objects, deliberately loose, CI passes tighter ones with -Thresholds */
+	struct FDefaultThreshold
+	{
+		const TCHAR* Stage;
+		double SecondsPerMillion;
+	};
+	const FDefaultThreshold DefaultThresholds[] = {
+		{ TEXT("ClassHistogram"), 1.0 },
+		{ TEXT("NameIndex"), 8.0 },
+		{ TEXT("Scan"), 1.0 },
+		{ TEXT("Filter"), 1.0 },
+		{ TEXT("NameFilter"), 0.1 },
+		{ TEXT("RowStore"), 0.5 },
+		{ TEXT("Sort"), 2.0 },
+		{ TEXT("PublishDelta"), 1.0 },
+		{ TEXT("RowGeneration"), 10.0 },
+		{ TEXT("GraphLayout"), 20.0 },
+	};
+
+	/* Run a stage a few times, keeping the best and median wall time */
+	template <typename StageFunctionType>
+	FUBrowseBenchmarkStage TimeStage(const TCHAR* Stage, int32 NumItems, int32 Iterations, StageFunctionType&& StageFunction)
+	{
+		TArray<double> Times;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			StageFunction();
+			Times.Add(FPlatformTime::Seconds() - StartTime);
+		}
+		Times.Sort();
+
+		FUBrowseBenchmarkStage Result;
+		Result.Stage = Stage;
+		Result.BestSeconds = Times[0];
+		Result.MedianSeconds = Times[Times.Num() / 2];
+		Result.NumItems = NumItems;
+		UE_LOG(LogUBrowseBenchmark, Display, TEXT("%-16s best %8.4fs median %8.4fs over %d"), Stage, Result.BestSeconds, Result.MedianSeconds, NumItems);
+		return Result;
+	}
+
+	/**
+	 * Populate a transient package with NumObjects objects of a few classes, nested under each other.
+	 *
+	 * @param OutNameTarget Receives the name of a CurveVector near the middle for the name filter stage, empty if none was made
+	 */
+	UPackage* CreateSyntheticObjects(int32 NumObjects, FString& OutNameTarget)
+	{
+		UPackage* Package = CreatePackage(TEXT("/Temp/UBrowseBenchmark"));
+		Package->SetFlags(RF_Transient);
+		Package->AddToRoot();
+
+		UClass* const Classes[] = { UObject::StaticClass(), UCurveFloat::StaticClass(), UCurveVector::StaticClass(), UCurveLinearColor::StaticClass() };
+		TArray<UObject*> Outers;
+		Outers.Add(Package);
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			UObject* Outer = Outers[(Index / ObjectsPerOuter) % Outers.Num()];
+			UClass* Class = Classes[Index % UE_ARRAY_COUNT(Classes)];
+			const FName Name(*FString::Printf(TEXT("%s_%s_Item"), SyntheticNamePrefix, *Class->GetName()), Index + 1);
+			UObject* Object = NewObject<UObject>(Outer, Class, Name, RF_Transient);
+			if ((Class == UCurveVector::StaticClass()) && (OutNameTarget.IsEmpty() || (Index <= NumObjects / 2)))
+			{
+				OutNameTarget = Object->GetName();
+			}
+			if ((Index % ObjectsPerOuter) == 0)
+			{
+				Outers.Add(Object);
+			}
+		}
+		return Package;
+	}
+
+	void DestroySyntheticObjects(UPackage* Package)
+	{
+		ForEachObjectWithPackage(Package, [](UObject* Object)
+		{
+			Object->MarkAsGarbage();
+			return true;
+		});
+		Package->RemoveFromRoot();
+		Package->MarkAsGarbage();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	TMap<FString, double> LoadThresholds(const FString& Filename)
+	{
+		TMap<FString, double> Thresholds;
+		for (const FDefaultThreshold& Default : DefaultThresholds)
+		{
+			Thresholds.Add(Default.Stage, Default.SecondsPerMillion);
+		}
+
+		FString JsonText;
+		TSharedPtr<FJsonObject> JsonObject;
+		if (!Filename.IsEmpty() && FFileHelper::LoadFileToString(JsonText, *Filename) && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), JsonObject) && JsonObject.IsValid())
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : JsonObject->Values)
+			{
+				double SecondsPerMillion = 0.0;
+				if (Field.Value->TryGetNumber(SecondsPerMillion))
+				{
+					Thresholds.Add(Field.Key, SecondsPerMillion);
+				}
+			}
+		}
+		else if (!Filename.IsEmpty())
+		{
+			UE_LOG(LogUBrowseBenchmark, Warning, TEXT("Could not read thresholds from %s, using the defaults"), *Filename);
+		}
+		return Thresholds;
+	}
+}
+
+FString FUBrowseBenchmarkStage::GetFailure() const
+{
+	if (!Invalid.IsEmpty())
+	{
+		return FString::Printf(TEXT("%s %s"), *Stage, *Invalid);
+	}
+	if (!Passed())
+	{
+		return FString::Printf(TEXT("%s took %.3fs per million, over the %.3fs limit"), *Stage, GetSecondsPerMillion(), ThresholdSecondsPerMillion);
+	}
+	return FString();
+}
+
+FUBrowseBenchmark::FUBrowseBenchmark(int32 InNumObjects, int32 InIterations, const FString& ThresholdsFile)
+	: NumObjects(FMath::Max(InNumObjects, 1))
+	, Iterations(FMath::Max(InIterations, 1))
+	, Thresholds(LoadThresholds(ThresholdsFile))
+{
+}
+
+bool FUBrowseBenchmark::Run(FString& OutError)
+{
+	UE_LOG(LogUBrowseBenchmark, Display, TEXT("Creating %d synthetic objects"), NumObjects);
+	FString NameQuery;
+	UPackage* Package = CreateSyntheticObjects(NumObjects, NameQuery);
+	if (NameQuery.IsEmpty())
+	{
+		OutError = FString::Printf(TEXT("%d objects are too few to include a CurveVector for the NameFilter stage"), NumObjects);
+		DestroySyntheticObjects(Package);
+		return false;
+	}
+	NumLiveObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+	// the synthetic objects live in a transient package, which the browser hides by default
+	FUBrowseObjectFilter ScanFilter;
+	ScanFilter.FilterClass = UObject::StaticClass();
+	ScanFilter.bIncludeTransient = true;
+
+	FUBrowseObjectFilter ClassFilter = ScanFilter;
+	ClassFilter.FilterClass = UCurveFloat::StaticClass();
+
+	FUBrowseObjectFilter NameFilter = ScanFilter;
+	FText QueryError;
+	NameFilter.SetQueryText(NameQuery, QueryError);
+
+	Stages.Reset();
+	FUBrowseClassHistogram Histogram;
+	FUBrowseNameIndex NameIndex;
+	FUBrowseQueryIndices Indices;
+	Indices.Histogram = &Histogram;
+	Indices.NameIndex = &NameIndex;
+
+	Stages.Add(TimeStage(TEXT("ClassHistogram"), NumLiveObjects, Iterations, [&Histogram]() { Histogram.Rebuild(); }));
+	Stages.Add(TimeStage(TEXT("NameIndex"), NumLiveObjects, Iterations, [&NameIndex]() { NameIndex.Rebuild(); }));
+
+	TArray<UObject*> ScannedObjects;
+	Stages.Add(TimeStage(TEXT("Scan"), NumLiveObjects, Iterations, [&ScanFilter, &ScannedObjects]()
+	{
+		ScannedObjects.Reset();
+		FUBrowseObjectScanner::ScanAll(ScanFilter, EUBrowseScanMode::Parallel, ScannedObjects);
+	}));
+
+	Stages.Add(TimeStage(TEXT("Filter"), NumLiveObjects, Iterations, [&ClassFilter, &Indices]()
+	{
+		TArray<UObject*> Objects;
+		FUBrowseObjectScanner::Query(ClassFilter, EUBrowseScanMode::Parallel, Indices, Objects);
+	}));
+
+	int32 NumNameMatches = 0;
+	Stages.Add(TimeStage(TEXT("NameFilter"), NumLiveObjects, Iterations, [&NameFilter, &Indices, &NumNameMatches]()
+	{
+		TArray<UObject*> Objects;
+		FUBrowseObjectScanner::Query(NameFilter, EUBrowseScanMode::Parallel, Indices, Objects);
+		NumNameMatches = Objects.Num();
+	}));
+	if (NumNameMatches == 0)
+	{
+		// a query that finds nothing can skip most of the work, its time says nothing about a real search
+		Stages.Last().Invalid = FString::Printf(TEXT("found nothing for %s"), *NameQuery);
+	}
+
+	FUBrowseObjectRows Rows;
+	Stages.Add(TimeStage(TEXT("RowStore"), ScannedObjects.Num(), Iterations, [&ScannedObjects, &Rows]()
+	{
+		Rows.Reset();
+		Rows.Reserve(ScannedObjects.Num());
+		for (UObject* Object : ScannedObjects)
+		{
+			Rows.Add(Object);
+		}
+	}));
+
+	const TArray<FUBrowseSortColumn> SortColumns = { FUBrowseSortColumn{ EQuerySortMode::ByName } };
+	FUBrowseObjectRows SortedRows;
+	Stages.Add(TimeStage(TEXT("Sort"), Rows.Num(), Iterations, [&Rows, &SortColumns, &SortedRows]()
+	{
+		TArray<FUBrowseSortKey> Keys;
+		FUBrowseObjectSorter::BuildKeys(Rows, Keys);
+		FUBrowseObjectSorter::SortKeys(Keys, SortColumns);
+		TArray<int32> Order;
+		Order.SetNumUninitialized(Keys.Num());
+		for (int32 Row = 0; Row < Keys.Num(); ++Row)
+		{
+			Order[Row] = Keys[Row].Row;
+		}
+		SortedRows = Rows;
+		SortedRows.Permute(Order);
+	}));
+
+	// a refresh that lost every hundredth row, what a steady trickle of deletions looks like
+	FUBrowseObjectRows ThinnedRows;
+	ThinnedRows.Reserve(SortedRows.Num());
+	for (int32 Row = 0; Row < SortedRows.Num(); ++Row)
+	{
+		UObject* Object = SortedRows.Handles[Row].Get();
+		if (((Row % 100) != 0) && (Object != nullptr))
+		{
+			ThinnedRows.Add(Object);
+		}
+	}
+	Stages.Add(TimeStage(TEXT("PublishDelta"), SortedRows.Num(), Iterations, [&SortedRows, &ThinnedRows, &SortColumns]()
+	{
+		FUBrowseListDelta::Compute(SortedRows, ThinnedRows, SortColumns, SortedRows.Num() / 2);
+	}));
+
+	// the text each generated row formats, with a cold cache every run
+	const int32 NumRowsToFormat = FMath::Min(RowsToFormat, SortedRows.Num());
+	Stages.Add(TimeStage(TEXT("RowGeneration"), NumRowsToFormat, Iterations, [&SortedRows, NumRowsToFormat]()
+	{
+		FUBrowseRowTextCache TextCache(NumRowsToFormat);
+		for (int32 Row = 0; Row < NumRowsToFormat; ++Row)
+		{
+			const TWeakObjectPtr<UObject>& Handle = SortedRows.Handles[Row];
+			TextCache.GetName(Handle);
+			TextCache.GetClassName(Handle);
+			TextCache.GetNumber(Handle);
+			TextCache.GetId(Handle);
+		}
+	}));
+
+	// a tree four wide with links across it and back up, so there are cycles to break and crossings to sort out
+	TArray<FVector2D> NodeSizes;
+	TArray<TPair<int32, int32>> NodeLinks;
+	FRandomStream LayoutRandom(GraphLayoutNodes);
+	for (int32 Node = 0; Node < GraphLayoutNodes; ++Node)
+	{
+		NodeSizes.Emplace(LayoutRandom.FRandRange(250.0f, 400.0f), LayoutRandom.FRandRange(80.0f, 160.0f));
+		if (Node > 0)
+		{
+			NodeLinks.Emplace((Node - 1) / 4, Node);
+		}
+		if (Node % 5 == 0)
+		{
+			NodeLinks.Emplace(Node, LayoutRandom.RandHelper(GraphLayoutNodes));
+		}
+	}
+	Stages.Add(TimeStage(TEXT("GraphLayout"), GraphLayoutNodes, Iterations, [&NodeSizes, &NodeLinks]()
+	{
+		TArray<FVector2D> Positions;
+		FUBrowseGraphLayout::Compute(NodeSizes, NodeLinks, Positions);
+	}));
+
+	DestroySyntheticObjects(Package);
+
+	for (FUBrowseBenchmarkStage& Stage : Stages)
+	{
+		const double* Threshold = Thresholds.Find(Stage.Stage);
+		Stage.ThresholdSecondsPerMillion = Threshold != nullptr ? *Threshold : TNumericLimits<double>::Max();
+	}
+	return true;
+}
+
+bool FUBrowseBenchmark::AllPassed() const
+{
+	return Algo::AllOf(Stages, [](const FUBrowseBenchmarkStage& Stage) { return Stage.Passed(); });
+}
+
+bool FUBrowseBenchmark::WriteReport(const FString& Filename) const
+{
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("objects"), NumObjects);
+	Report->SetNumberField(TEXT("liveObjects"), NumLiveObjects);
+	Report->SetNumberField(TEXT("iterations"), Iterations);
+	Report->SetStringField(TEXT("time"), FDateTime::UtcNow().ToIso8601());
+	TArray<TSharedPtr<FJsonValue>> StageValues;
+	for (const FUBrowseBenchmarkStage& Result : Stages)
+	{
+		TSharedRef<FJsonObject> Stage = MakeShared<FJsonObject>();
+		Stage->SetStringField(TEXT("name"), Result.Stage);
+		Stage->SetNumberField(TEXT("items"), Result.NumItems);
+		Stage->SetNumberField(TEXT("bestSeconds"), Result.BestSeconds);
+		Stage->SetNumberField(TEXT("medianSeconds"), Result.MedianSeconds);
+		Stage->SetNumberField(TEXT("secondsPerMillion"), Result.GetSecondsPerMillion());
+		if (Result.ThresholdSecondsPerMillion < TNumericLimits<double>::Max())
+		{
+			Stage->SetNumberField(TEXT("thresholdSecondsPerMillion"), Result.ThresholdSecondsPerMillion);
+		}
+		if (!Result.Invalid.IsEmpty())
+		{
+			Stage->SetStringField(TEXT("invalid"), Result.Invalid);
+		}
+		Stage->SetBoolField(TEXT("passed"), Result.Passed());
+		StageValues.Add(MakeShared<FJsonValueObject>(Stage));
+	}
+	Report->SetArrayField(TEXT("stages"), StageValues);
+	Report->SetBoolField(TEXT("passed"), AllPassed());
+
+	FString ReportText;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportText));
+	return FFileHelper::SaveStringToFile(ReportText, *Filename);
+}
+
+FString FUBrowseBenchmark::GetDefaultReportFile()
+{
+	return FPaths::ProjectSavedDir() / TEXT("UBrowse") / TEXT("Benchmark") / FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString());
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* How long one stage of the benchmark took and whether that is within its limit */
+struct FUBrowseBenchmarkStage
+{
+	FString Stage;
+	double BestSeconds = 0.0;
+	double MedianSeconds = 0.0;
+	/* Objects the stage works over, what SecondsPerMillion is relative to */
+	int32 NumItems = 0;
+	double ThresholdSecondsPerMillion = 0.0;
+	/* Why the stage did not do the work it times, however fast it was. Empty when it did */
+	FString Invalid;
+
+	double GetSecondsPerMillion() const { return NumItems > 0 ? MedianSeconds * 1000000.0 / NumItems : 0.0; }
+	bool Passed() const { return Invalid.IsEmpty() && (GetSecondsPerMillion() <= ThresholdSecondsPerMillion); }
+
+	/** What went wrong, for the log or the test report, empty if the stage passed */
+	FString GetFailure() const;
+};
+
+/**
+ * Times the stages of the object list pipeline over a synthetic object population: index builds, scans,
+ * filters, the row store, sorting, publishing, row text and graph layout. Run by the UBrowse.Perf automation
+ * tests and the UBrowseBenchmark commandlet, which both check the stages against per stage limits in seconds
+ * per million objects and write the results as a JSON report.
+ */
+class FUBrowseBenchmark
+{
+public:
+	/* Objects created when nothing else is asked for */
+	static constexpr int32 DefaultNumObjects = 1000 * 1000;
+
+	/**
+	 * @param InNumObjects     Synthetic objects to create
+	 * @param InIterations     Runs per stage, the median is what is checked
+	 * @param ThresholdsFile   JSON object of stage name to allowed seconds per million objects, overriding the built in limits. Optional
+	 */
+	FUBrowseBenchmark(int32 InNumObjects, int32 InIterations, const FString& ThresholdsFile = FString());
+
+	/**
+	 * Create the objects, time every stage and destroy them again.
+	 *
+	 * @return false if the benchmark could not run at all, with the reason in OutError
+	 */
+	bool Run(FString& OutError);
+
+	const TArray<FUBrowseBenchmarkStage>& GetStages() const { return Stages; }
+
+	bool AllPassed() const;
+
+	bool WriteReport(const FString& Filename) const;
+
+	/** Saved/UBrowse/Benchmark/Benchmark-<time>.json */
+	static FString GetDefaultReportFile();
+
+private:
+	int32 NumObjects;
+	int32 Iterations;
+	int32 NumLiveObjects = 0;
+	TMap<FString, double> Thresholds;
+	TArray<FUBrowseBenchmarkStage> Stages;
+};
@@ -0,0 +1,61 @@
+#include "UBrowseBenchmarkCommandlet.h"
+#include "UBrowseBenchmark.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUBrowseBenchmark, Log, All);
+
+UUBrowseBenchmarkCommandlet::UUBrowseBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Times the object list pipeline over synthetic objects and fails when a stage regresses, the same run as the UBrowse.Perf automation tests");
+	HelpUsage = TEXT("-run=UBrowseBenchmark [-Objects=1000000] [-Iterations=5] [-Report=File.json] [-Thresholds=File.json]");
+	HelpParamNames = { TEXT("Objects"), TEXT("Iterations"), TEXT("Report"), TEXT("Thresholds") };
+	HelpParamDescriptions = {
+		TEXT("Synthetic objects to create, 1000000 by default"),
+		TEXT("Runs per stage, the median is what is checked. 5 by default"),
+		TEXT("JSON report to write, defaults to Saved/UBrowse/Benchmark"),
+		TEXT("JSON object of stage name to allowed seconds per million objects, overriding the built in limits") };
+}
+
+int32 UUBrowseBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumObjects = FUBrowseBenchmark::DefaultNumObjects;
+	int32 Iterations = 5;
+	FString ReportFile;
+	FString ThresholdsFile;
+	FParse::Value(*Params, TEXT("Objects="), NumObjects);
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Report="), ReportFile);
+	FParse::Value(*Params, TEXT("Thresholds="), ThresholdsFile);
+	if (ReportFile.IsEmpty())
+	{
+		ReportFile = FUBrowseBenchmark::GetDefaultReportFile();
+	}
+
+	FUBrowseBenchmark Benchmark(NumObjects, Iterations, ThresholdsFile);
+	FString Error;
+	if (!Benchmark.Run(Error))
+	{
+		UE_LOG(LogUBrowseBenchmark, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+	for (const FUBrowseBenchmarkStage& Stage : Benchmark.GetStages())
+	{
+		if (!Stage.Passed())
+		{
+			UE_LOG(LogUBrowseBenchmark, Error, TEXT("%s"), *Stage.GetFailure());
+		}
+	}
+
+	if (!Benchmark.WriteReport(ReportFile))
+	{
+		UE_LOG(LogUBrowseBenchmark, Error, TEXT("Could not write %s"), *ReportFile);
+		return 1;
+	}
+	const bool bAllPassed = Benchmark.AllPassed();
+	UE_LOG(LogUBrowseBenchmark, Display, TEXT("Wrote %s, %s"), *ReportFile, bAllPassed ? TEXT("all stages within their limits") : TEXT("some stages regressed"));
+	return bAllPassed ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "UBrowseBenchmarkCommandlet.generated.h"
+
+/**
+ * Times the stages of the object list pipeline over a synthetic object population and writes a JSON
+ * report, failing with a nonzero exit code when a stage is slower than its threshold. Runs FUBrowseBenchmark
+ * like the UBrowse.Perf automation tests, for machines that run commandlets rather than automation.
+ *
+ * UnrealEditor-Cmd Project.uproject -run=UBrowseBenchmark -Objects=1000000 -Report=Bench.json -nullrhi
+ *
+ * The class carries a second U so that -run=UBrowseBenchmark finds it.
+ */
+UCLASS()
+class UUBrowseBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+  public:
+    UUBrowseBenchmarkCommandlet();
+
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString& Params) override;
+    //~ End UCommandlet Interface
+};
@@ -0,0 +1,385 @@
+#include "UBrowseCensusCommandlet.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "UBrowseClassHistogram.h"
+#include "UBrowseObjectFilter.h"
+#include "UBrowseObjectRows.h"
+#include "UBrowseObjectScanner.h"
+#include "UBrowseObjectSizes.h"
+#include "UBrowseObjectSort.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUBrowseCensus, Log, All);
+
+namespace
+{
+	/* Writes census records as CSV or JSON Lines, buffering a chunk of text at a time */
+	class FCensusWriter
+	{
+	public:
+		static constexpr int32 FlushThreshold = 64 * 1024;
+
+		FCensusWriter(FArchive& InArchive, bool bInJsonLines)
+			: Archive(InArchive)
+			, bJsonLines(bInJsonLines)
+		{
+		}
+
+		~FCensusWriter()
+		{
+			Flush();
+		}
+
+		void WriteObjectHeader(bool bWithSizes)
+		{
+			if (!bJsonLines)
+			{
+				Buffer += bWithSizes ? TEXT("class,name,path,outer,flags,exclusiveSize,inclusiveSize\n") : TEXT("class,name,path,outer,flags\n");
+			}
+		}
+
+		void WriteObject(const UObject* Object, const FUBrowseObjectSize* Size)
+		{
+			const UObject* Outer = Object->GetOuter();
+			BeginRecord(TEXT("object"));
+			AddField(TEXT("class"), Object->GetClass()->GetPathName());
+			AddField(TEXT("name"), Object->GetName());
+			AddField(TEXT("path"), Object->GetPathName());
+			AddField(TEXT("outer"), Outer != nullptr ? Outer->GetPathName() : FString());
+			AddField(TEXT("flags"), FString::Printf(TEXT("0x%08x"), uint32(Object->GetFlags())));
+			if (Size != nullptr)
+			{
+				AddNumber(TEXT("exclusiveSize"), Size->Exclusive);
+				AddNumber(TEXT("inclusiveSize"), Size->Inclusive);
+			}
+			EndRecord();
+		}
+
+		void WriteClassHeader(bool bWithSizes)
+		{
+			if (!bJsonLines)
+			{
+				Buffer += bWithSizes ? TEXT("class,count,exclusiveSize,inclusiveSize\n") : TEXT("class,count\n");
+			}
+		}
+
+		void WriteClass(const UClass* Class, const FUBrowseSizeTotal& Total, bool bWithSizes)
+		{
+			BeginRecord(TEXT("class"));
+			AddField(TEXT("class"), Class->GetPathName());
+			AddNumber(TEXT("count"), Total.NumObjects);
+			if (bWithSizes)
+			{
+				AddNumber(TEXT("exclusiveSize"), Total.Size.Exclusive);
+				AddNumber(TEXT("inclusiveSize"), Total.Size.Inclusive);
+			}
+			EndRecord();
+		}
+
+		void Flush()
+		{
+			if (Buffer.Len() > 0)
+			{
+				const FTCHARToUTF8 Utf8Buffer(*Buffer, Buffer.Len());
+				Archive.Serialize(const_cast<ANSICHAR*>(Utf8Buffer.Get()), Utf8Buffer.Length());
+				Buffer.Reset();
+			}
+		}
+
+	private:
+		void BeginRecord(const TCHAR* RecordType)
+		{
+			bFirstField = true;
+			if (bJsonLines)
+			{
+				Buffer += TEXT("{\"type\":\"");
+				Buffer += RecordType;
+				Buffer += TEXT("\"");
+				bFirstField = false;
+			}
+		}
+
+		void EndRecord()
+		{
+			Buffer += bJsonLines ? TEXT("}\n") : TEXT("\n");
+			if (Buffer.Len() >= FlushThreshold)
+			{
+				Flush();
+			}
+		}
+
+		void BeginField(const TCHAR* Key)
+		{
+			if (!bFirstField)
+			{
+				Buffer += TEXT(",");
+			}
+			bFirstField = false;
+			if (bJsonLines)
+			{
+				Buffer += TEXT("\"");
+				Buffer += Key;
+				Buffer += TEXT("\":");
+			}
+		}
+
+		void AddField(const TCHAR* Key, const FString& Value)
+		{
+			BeginField(Key);
+			if (bJsonLines)
+			{
+				AppendJsonString(Value);
+			}
+			else
+			{
+				AppendCsvField(Value);
+			}
+		}
+
+		void AddNumber(const TCHAR* Key, int64 Value)
+		{
+			BeginField(Key);
+			Buffer += FString::Printf(TEXT("%lld"), Value);
+		}
+
+		void AppendCsvField(const FString& Value)
+		{
+			int32 Index;
+			const bool bNeedsQuotes = Value.FindChar(TEXT(','), Index) || Value.FindChar(TEXT('"'), Index) || Value.FindChar(TEXT('\n'), Index);
+			if (!bNeedsQuotes)
+			{
+				Buffer += Value;
+				return;
+			}
+			Buffer += TEXT("\"");
+			Buffer += Value.Replace(TEXT("\""), TEXT("\"\""));
+			Buffer += TEXT("\"");
+		}
+
+		void AppendJsonString(const FString& Value)
+		{
+			Buffer += TEXT("\"");
+			for (TCHAR Char : Value)
+			{
+				switch (Char)
+				{
+				case TEXT('"'):
+					Buffer += TEXT("\\\"");
+					break;
+				case TEXT('\\'):
+					Buffer += TEXT("\\\\");
+					break;
+				case TEXT('\n'):
+					Buffer += TEXT("\\n");
+					break;
+				case TEXT('\r'):
+					Buffer += TEXT("\\r");
+					break;
+				case TEXT('\t'):
+					Buffer += TEXT("\\t");
+					break;
+				default:
+					if (Char < 0x20)
+					{
+						Buffer += FString::Printf(TEXT("\\u%04x"), uint32(Char));
+					}
+					else
+					{
+						Buffer.AppendChar(Char);
+					}
+					break;
+				}
+			}
+			Buffer += TEXT("\"");
+		}
+
+		FArchive& Archive;
+		FString Buffer;
+		bool bJsonLines;
+		bool bFirstField = true;
+	};
+
+	UClass* FindClassByName(const FString& ClassName)
+	{
+		return FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst | EFindFirstObjectOptions::EnsureIfAmbiguous);
+	}
+}
+
+UUBrowseCensusCommandlet::UUBrowseCensusCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Lists the live objects after loading a map or packages, with per class counts and sizes");
+	HelpUsage = TEXT("-run=UBrowseCensus [-Map=/Game/Map] [-Packages=/Game/A+/Game/B] [-Class=StaticMesh] [-Query=\"name:Foo flags:-Transient\"] [-Output=File.csv|File.jsonl] [-Format=csv|jsonl]");
+	HelpParamNames = { TEXT("Map"), TEXT("Packages"), TEXT("Class"), TEXT("Query"), TEXT("Output"), TEXT("Format"), TEXT("NoSizes"), TEXT("NoGC"), TEXT("NoCDOs"), TEXT("NoDefaultSubobjects"), TEXT("NoArchetypes"), TEXT("RootOnly"), TEXT("GCOnly"), TEXT("IncludeTransient") };
+	HelpParamDescriptions = {
+		TEXT("Map package to load first"),
+		TEXT("Further packages to load, separated by +"),
+		TEXT("Only list objects of this class, short name or path"),
+		TEXT("Browser filter query, same syntax as the filter box"),
+		TEXT("File to write, the class totals go next to it with a _Classes suffix. Defaults to Saved/UBrowse/Census"),
+		TEXT("csv or jsonl, taken from the output extension when not given"),
+		TEXT("Skip measuring object sizes"),
+		TEXT("Do not collect garbage between loading and listing"),
+		TEXT("Leave class default objects out"),
+		TEXT("Leave default subobjects out"),
+		TEXT("Leave archetypes out"),
+		TEXT("Only list root set objects"),
+		TEXT("Only list objects that are not GC-exempt"),
+		TEXT("Include objects in the transient package") };
+}
+
+int32 UUBrowseCensusCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+	auto HasSwitch = [&Switches](const TCHAR* Switch) { return Switches.ContainsByPredicate([Switch](const FString& Entry) { return Entry.Equals(Switch, ESearchCase::IgnoreCase); }); };
+	auto GetParam = [&ParamValues](const TCHAR* Name) { const FString* Value = ParamValues.Find(Name); return Value != nullptr ? *Value : FString(); };
+
+	// load what is to be counted, the packages are held so the collection below only drops load time garbage
+	TArray<FString> PackageNames;
+	const FString MapName = GetParam(TEXT("Map"));
+	if (!MapName.IsEmpty())
+	{
+		PackageNames.Add(MapName);
+	}
+	TArray<FString> ExtraPackageNames;
+	GetParam(TEXT("Packages")).ParseIntoArray(ExtraPackageNames, TEXT("+"));
+	PackageNames.Append(ExtraPackageNames);
+
+	TArray<TStrongObjectPtr<UPackage>> LoadedPackages;
+	for (const FString& PackageName : PackageNames)
+	{
+		UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+		if (Package == nullptr)
+		{
+			UE_LOG(LogUBrowseCensus, Error, TEXT("Failed to load %s"), *PackageName);
+			return 1;
+		}
+		LoadedPackages.Emplace(Package);
+	}
+	if (!HasSwitch(TEXT("NoGC")))
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	FUBrowseObjectFilter Filter;
+	Filter.bShouldIncludeClassDefaultObjects = !HasSwitch(TEXT("NoCDOs"));
+	Filter.bShouldIncludeDefaultSubObjects = !HasSwitch(TEXT("NoDefaultSubobjects"));
+	Filter.bShouldIncludeArchetypeObjects = !HasSwitch(TEXT("NoArchetypes"));
+	Filter.bOnlyListRootObjects = HasSwitch(TEXT("RootOnly"));
+	Filter.bOnlyListGCObjects = HasSwitch(TEXT("GCOnly"));
+	Filter.bIncludeTransient = HasSwitch(TEXT("IncludeTransient"));
+	Filter.FilterClass = UObject::StaticClass();
+
+	const FString ClassName = GetParam(TEXT("Class"));
+	if (!ClassName.IsEmpty())
+	{
+		Filter.FilterClass = FindClassByName(ClassName);
+		if (Filter.FilterClass == nullptr)
+		{
+			UE_LOG(LogUBrowseCensus, Error, TEXT("Unknown class %s"), *ClassName);
+			return 1;
+		}
+	}
+
+	FText QueryError;
+	if (!Filter.SetQueryText(GetParam(TEXT("Query")), QueryError))
+	{
+		UE_LOG(LogUBrowseCensus, Error, TEXT("Bad query: %s"), *QueryError.ToString());
+		return 1;
+	}
+
+	// same planner the browser uses, the histogram tells it whether a class lookup beats a scan
+	FUBrowseClassHistogram Histogram;
+	Histogram.Rebuild();
+	FUBrowseQueryIndices Indices;
+	Indices.Histogram = &Histogram;
+
+	const double QueryStartTime = FPlatformTime::Seconds();
+	TArray<UObject*> MatchingObjects;
+	const EUBrowseQueryPlan Plan = FUBrowseObjectScanner::Query(Filter, EUBrowseScanMode::Parallel, Indices, MatchingObjects, nullptr);
+
+	FUBrowseObjectRows Rows;
+	Rows.Reserve(MatchingObjects.Num());
+	for (UObject* Object : MatchingObjects)
+	{
+		Rows.Add(Object);
+	}
+	const TArray<FUBrowseSortColumn> SortColumns = { FUBrowseSortColumn{ EQuerySortMode::ByType }, FUBrowseSortColumn{ EQuerySortMode::ByName } };
+	TArray<FUBrowseSortKey> Keys;
+	FUBrowseObjectSorter::BuildKeys(Rows, Keys);
+	FUBrowseObjectSorter::SortKeys(Keys, SortColumns);
+	UE_LOG(LogUBrowseCensus, Display, TEXT("Listed %d of %d objects in %.3fs (plan %d)"), Rows.Num(), Histogram.GetTotalCount(), FPlatformTime::Seconds() - QueryStartTime, int32(Plan));
+
+	FString Output = GetParam(TEXT("Output"));
+	if (Output.IsEmpty())
+	{
+		Output = FPaths::ProjectSavedDir() / TEXT("UBrowse") / TEXT("Census") / FString::Printf(TEXT("Census-%s.csv"), *FDateTime::Now().ToString());
+	}
+	FString Format = GetParam(TEXT("Format"));
+	if (Format.IsEmpty())
+	{
+		Format = FPaths::GetExtension(Output);
+	}
+	const bool bJsonLines = Format.Equals(TEXT("jsonl"), ESearchCase::IgnoreCase) || Format.Equals(TEXT("json"), ESearchCase::IgnoreCase);
+	const bool bWithSizes = !HasSwitch(TEXT("NoSizes"));
+
+	const FString ClassOutput = FPaths::GetPath(Output) / (FPaths::GetBaseFilename(Output) + TEXT("_Classes.") + (bJsonLines ? TEXT("jsonl") : TEXT("csv")));
+	TUniquePtr<FArchive> ObjectArchive(IFileManager::Get().CreateFileWriter(*Output));
+	TUniquePtr<FArchive> ClassArchive(IFileManager::Get().CreateFileWriter(*ClassOutput));
+	if (!ObjectArchive.IsValid() || !ClassArchive.IsValid())
+	{
+		UE_LOG(LogUBrowseCensus, Error, TEXT("Could not create %s"), !ObjectArchive.IsValid() ? *Output : *ClassOutput);
+		return 1;
+	}
+
+	// objects are measured as they are written, nothing per object is kept past its line
+	TMap<const UClass*, FUBrowseSizeTotal> ClassTotals;
+	{
+		FCensusWriter ObjectWriter(*ObjectArchive, bJsonLines);
+		ObjectWriter.WriteObjectHeader(bWithSizes);
+		for (const FUBrowseSortKey& Key : Keys)
+		{
+			UObject* Object = Rows.Handles[Key.Row].Get();
+			if (Object == nullptr)
+			{
+				continue;
+			}
+			const FUBrowseObjectSize Size = bWithSizes ? FUBrowseObjectSizes::Measure(Object) : FUBrowseObjectSize();
+			ObjectWriter.WriteObject(Object, bWithSizes ? &Size : nullptr);
+			ClassTotals.FindOrAdd(Object->GetClass()).Add(Size);
+		}
+	}
+
+	ClassTotals.ValueSort([](const FUBrowseSizeTotal& A, const FUBrowseSizeTotal& B)
+	{
+		return A.Size.Exclusive != B.Size.Exclusive ? A.Size.Exclusive > B.Size.Exclusive : A.NumObjects > B.NumObjects;
+	});
+	{
+		FCensusWriter ClassWriter(*ClassArchive, bJsonLines);
+		ClassWriter.WriteClassHeader(bWithSizes);
+		for (const TPair<const UClass*, FUBrowseSizeTotal>& ClassTotal : ClassTotals)
+		{
+			ClassWriter.WriteClass(ClassTotal.Key, ClassTotal.Value, bWithSizes);
+		}
+	}
+
+	const bool bWritten = ObjectArchive->Close() && ClassArchive->Close();
+	if (!bWritten)
+	{
+		UE_LOG(LogUBrowseCensus, Error, TEXT("Failed writing %s"), *Output);
+		return 1;
+	}
+	UE_LOG(LogUBrowseCensus, Display, TEXT("Wrote %s and %s"), *Output, *ClassOutput);
+	return 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "UBrowseCensusCommandlet.generated.h"
+
+/**
+ * Headless object census. Loads a map and/or packages, lists the live objects through the same filter
+ * and query engine as the browser's object list and streams them to disk, followed by per class totals.
+ *
+ * UnrealEditor-Cmd Project.uproject -run=UBrowseCensus -Map=/Game/Maps/Entry -Output=Census.jsonl -nullrhi
+ *
+ * The class carries a second U so that -run=UBrowseCensus finds it.
+ */
+UCLASS()
+class UUBrowseCensusCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+  public:
+    UUBrowseCensusCommandlet();
+
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString& Params) override;
+    //~ End UCommandlet Interface
+};
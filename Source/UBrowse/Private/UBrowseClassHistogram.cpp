@@ -0,0 +1,182 @@
+#include "UBrowseClassHistogram.h"
+#include "UObject/Class.h"
+#include "UObject/UObjectArray.h"
+#include "UBrowseStats.h"
+
+FUBrowseClassHistogram::FUBrowseClassHistogram()
+{
+}
+
+FUBrowseClassHistogram::~FUBrowseClassHistogram()
+{
+	Tracker.StopTracking();
+}
+
+DECLARE_CYCLE_STAT(TEXT("Class Histogram Rebuild"), STAT_UBrowse_HistogramRebuild, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Class Histogram Update"), STAT_UBrowse_HistogramUpdate, STATGROUP_UBrowse);
+
+void FUBrowseClassHistogram::Rebuild()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_HistogramRebuild);
+
+	ClassSlots.Reset();
+	ClassObjectIndexToSlot.Reset();
+	SlotClasses.Reset();
+	SlotParents.Reset();
+	ExclusiveCounts.Reset();
+	InclusiveCounts.Reset();
+	TotalCount = 0;
+
+	// start listening before the scan, anything created during it is de-duplicated through ObjectSlots
+	Tracker.StartTracking();
+	Tracker.Reset();
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	ObjectSlots.Init(INDEX_NONE, NumObjects);
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		bool bNotReady = false;
+		UObject* Object = FUBrowseObjectTracker::ResolveObject(ObjectIndex, bNotReady);
+		if (bNotReady)
+		{
+			Tracker.DeferCreated(ObjectIndex);
+		}
+		if (Object == nullptr)
+		{
+			continue;
+		}
+		const int32 Slot = FindOrAddClassSlot(Object->GetClass());
+		ExclusiveCounts[Slot]++;
+		ObjectSlots[ObjectIndex] = Slot;
+		TotalCount++;
+	}
+
+	// fold subclass totals into their parents, children always have higher slots than their super class
+	InclusiveCounts = ExclusiveCounts;
+	for (int32 Slot = SlotParents.Num() - 1; Slot > 0; --Slot)
+	{
+		if (SlotParents[Slot] != INDEX_NONE)
+		{
+			InclusiveCounts[SlotParents[Slot]] += InclusiveCounts[Slot];
+		}
+	}
+
+	bValid = true;
+}
+
+void FUBrowseClassHistogram::Update()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_HistogramUpdate);
+
+	if (!bValid)
+	{
+		Rebuild();
+		return;
+	}
+
+	TArray<int32> CreatedIndices;
+	TArray<int32> DeletedIndices;
+	if (!Tracker.ConsumeChanges(CreatedIndices, DeletedIndices))
+	{
+		Rebuild();
+		return;
+	}
+
+	for (int32 ObjectIndex : DeletedIndices)
+	{
+		UncountObject(ObjectIndex);
+	}
+
+	for (int32 ObjectIndex : CreatedIndices)
+	{
+		if (ObjectSlots.IsValidIndex(ObjectIndex) && ObjectSlots[ObjectIndex] != INDEX_NONE)
+		{
+			continue;
+		}
+		bool bNotReady = false;
+		UObject* Object = FUBrowseObjectTracker::ResolveObject(ObjectIndex, bNotReady);
+		if (bNotReady)
+		{
+			Tracker.DeferCreated(ObjectIndex);
+		}
+		else if (Object != nullptr)
+		{
+			CountObject(ObjectIndex, Object);
+		}
+	}
+}
+
+int32 FUBrowseClassHistogram::GetExclusiveCount(const UClass* Class) const
+{
+	const int32* Slot = ClassSlots.Find(Class);
+	return Slot != nullptr ? ExclusiveCounts[*Slot] : 0;
+}
+
+int32 FUBrowseClassHistogram::GetInclusiveCount(const UClass* Class) const
+{
+	const int32* Slot = ClassSlots.Find(Class);
+	return Slot != nullptr ? InclusiveCounts[*Slot] : 0;
+}
+
+int32 FUBrowseClassHistogram::FindOrAddClassSlot(UClass* Class)
+{
+	if (const int32* ExistingSlot = ClassSlots.Find(Class))
+	{
+		return *ExistingSlot;
+	}
+
+	// parents first, keeps every super class slot below its children
+	UClass* SuperClass = Class->GetSuperClass();
+	const int32 ParentSlot = SuperClass != nullptr ? FindOrAddClassSlot(SuperClass) : INDEX_NONE;
+
+	const int32 Slot = SlotParents.Add(ParentSlot);
+	SlotClasses.Add(Class);
+	ExclusiveCounts.Add(0);
+	InclusiveCounts.Add(0);
+	ClassSlots.Add(Class, Slot);
+	ClassObjectIndexToSlot.Add(GUObjectArray.ObjectToIndex(Class), Slot);
+	return Slot;
+}
+
+void FUBrowseClassHistogram::AddToSlot(int32 Slot, int32 Delta)
+{
+	ExclusiveCounts[Slot] += Delta;
+	for (int32 Ancestor = Slot; Ancestor != INDEX_NONE; Ancestor = SlotParents[Ancestor])
+	{
+		InclusiveCounts[Ancestor] += Delta;
+	}
+	TotalCount += Delta;
+}
+
+void FUBrowseClassHistogram::CountObject(int32 ObjectIndex, UObject* Object)
+{
+	if (ObjectIndex >= ObjectSlots.Num())
+	{
+		const int32 OldNum = ObjectSlots.Num();
+		ObjectSlots.SetNumUninitialized(FMath::Max(ObjectIndex + 1, GUObjectArray.GetObjectArrayNum()));
+		for (int32 Index = OldNum; Index < ObjectSlots.Num(); ++Index)
+		{
+			ObjectSlots[Index] = INDEX_NONE;
+		}
+	}
+	const int32 Slot = FindOrAddClassSlot(Object->GetClass());
+	ObjectSlots[ObjectIndex] = Slot;
+	AddToSlot(Slot, 1);
+}
+
+void FUBrowseClassHistogram::UncountObject(int32 ObjectIndex)
+{
+	if (ObjectSlots.IsValidIndex(ObjectIndex) && ObjectSlots[ObjectIndex] != INDEX_NONE)
+	{
+		AddToSlot(ObjectSlots[ObjectIndex], -1);
+		ObjectSlots[ObjectIndex] = INDEX_NONE;
+	}
+
+	// a dying class retires its slot, the address may be reused by a new class
+	int32 ClassSlot = INDEX_NONE;
+	if (ClassObjectIndexToSlot.RemoveAndCopyValue(ObjectIndex, ClassSlot))
+	{
+		ClassSlots.Remove(SlotClasses[ClassSlot]);
+		SlotClasses[ClassSlot] = nullptr;
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UBrowseObjectTracker.h"
+
+/**
+ * Live instance counts per UClass, built with a single pass over GUObjectArray and then kept
+ * current from object create/delete events.
+ *
+ * Every class seen gets a dense slot; a slot's super class always has a lower slot index so
+ * subclass totals can be folded into their parents with one reverse sweep.
+ */
+class FUBrowseClassHistogram
+{
+public:
+	FUBrowseClassHistogram();
+	~FUBrowseClassHistogram();
+
+	/** Recount every live object from scratch */
+	void Rebuild();
+
+	/** Apply the objects created/deleted since the last update, rebuilding on first use or when the changes overflowed */
+	void Update();
+
+	/** @return Number of live objects whose class is exactly this class */
+	int32 GetExclusiveCount(const UClass* Class) const;
+
+	/** @return Number of live objects of this class or any subclass, what IsA() would count */
+	int32 GetInclusiveCount(const UClass* Class) const;
+
+	/** @return Number of live objects counted */
+	int32 GetTotalCount() const { return TotalCount; }
+
+	bool IsValid() const { return bValid; }
+
+private:
+	int32 FindOrAddClassSlot(UClass* Class);
+	void AddToSlot(int32 Slot, int32 Delta);
+	void CountObject(int32 ObjectIndex, UObject* Object);
+	void UncountObject(int32 ObjectIndex);
+
+	/* Class to its dense slot */
+	TMap<const UClass*, int32> ClassSlots;
+
+	/* GUObjectArray index of each slot's class, so the slot can be retired when the class dies */
+	TMap<int32, int32> ClassObjectIndexToSlot;
+
+	/* Class of each slot, only used as a key, null once the class is gone */
+	TArray<const UClass*> SlotClasses;
+
+	/* Slot of each slot's super class, INDEX_NONE for UObject */
+	TArray<int32> SlotParents;
+	TArray<int32> ExclusiveCounts;
+	TArray<int32> InclusiveCounts;
+
+	/* Per GUObjectArray index, the slot the object there was counted under */
+	TArray<int32> ObjectSlots;
+
+	FUBrowseObjectTracker Tracker;
+	int32 TotalCount = 0;
+	bool bValid = false;
+};
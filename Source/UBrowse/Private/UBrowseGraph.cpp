@@ -6,28 +6,425 @@
 #include "UBrowse.h"
 #include "UBrowseNode.h"
 #include "EdGraph/EdGraphNode.h"
-#include "EdGraphUtilities.h"
+#include "UBrowseGraphLayout.h"
 #include "UBrowseSchema.h"
+#include "UBrowseStats.h"
+#include "UBrowseObjectTracker.h"
+#include "UBrowseReferenceIndex.h"
+#include "UObject/UObjectArray.h"
 
 #define LOCTEXT_NAMESPACE "UBrowseGraph"
 
+DECLARE_CYCLE_STAT(TEXT("Refresh Graph"), STAT_UBrowse_RefreshGraph, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Layout Nodes"), STAT_UBrowse_LayoutNodes, STATGROUP_UBrowse);
+
 UBrowseGraph::UBrowseGraph(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
     Schema = UBrowseSchema::StaticClass();
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FCoreUObjectDelegates::OnObjectsReplaced.AddUObject(this, &UBrowseGraph::OnObjectsReplaced);
+	}
+}
+
+void UBrowseGraph::BeginDestroy()
+{
+	FCoreUObjectDelegates::OnObjectsReplaced.RemoveAll(this);
+	Super::BeginDestroy();
 }
 
 
 void UBrowseGraph::RefreshGraph(UObject* pRoot)
 {
-    constexpr int32 nodeYStart = 50;
+    SCOPE_CYCLE_COUNTER(STAT_UBrowse_RefreshGraph);
 
-    /* clear previous graph */
+	UObject* Root = pRoot == nullptr ? GEngine : pRoot;
+	RootObject = Root;
+	bWaitingForReferences = false;
+	StatusText = FText::GetEmpty();
+
+	if (Mode == EUBrowseGraphMode::Outers)
+	{
+		// reuses whatever the previous outer graph has in common with this one
+		BuildOuterGraph(Root);
+		return;
+	}
+
+	/* clear previous graph */
 	RemoveAllNodes();
+	if (Mode == EUBrowseGraphMode::References)
+	{
+		BuildReferenceGraph(Root);
+	}
+	else
+	{
+		BuildWhyAliveGraph(Root);
+	}
+}
+
+void UBrowseGraph::SetReferenceIndex(TSharedPtr<FUBrowseReferenceIndexCache> InReferenceIndex)
+{
+	if (ReferenceIndex.IsValid())
+	{
+		ReferenceIndex->OnIndexReady().RemoveAll(this);
+	}
+	ReferenceIndex = InReferenceIndex;
+	if (ReferenceIndex.IsValid())
+	{
+		ReferenceIndex->OnIndexReady().AddUObject(this, &UBrowseGraph::OnReferenceIndexReady);
+	}
+}
+
+void UBrowseGraph::SetMode(EUBrowseGraphMode InMode)
+{
+	if (Mode != InMode)
+	{
+		Mode = InMode;
+		RefreshGraph(RootObject.Get());
+	}
+}
+
+void UBrowseGraph::SetReferenceDepth(int32 InDepth)
+{
+	InDepth = FMath::Max(InDepth, 1);
+	if (ReferenceDepth != InDepth)
+	{
+		ReferenceDepth = InDepth;
+		if (Mode == EUBrowseGraphMode::References)
+		{
+			RefreshGraph(RootObject.Get());
+		}
+	}
+}
+
+void UBrowseGraph::ShowWhyAlive(TWeakObjectPtr<UObject> Object)
+{
+	Mode = EUBrowseGraphMode::WhyAlive;
+	RefreshGraph(Object.Get());
+}
+
+void UBrowseGraph::OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	// blueprint compiles reinstance the objects on show, the nodes keep their visuals until then
+	bool bAnyReplaced = false;
+	for (UEdGraphNode* Node : Nodes)
+	{
+		UBrowseNode* BrowseNode = Cast<UBrowseNode>(Node);
+		bAnyReplaced |= (BrowseNode != nullptr) && BrowseNode->ReplaceObject(ReplacementMap);
+	}
+	for (FUBrowseOuterLink& Link : OuterChain)
+	{
+		if (UObject* const* Replacement = ReplacementMap.Find(Link.Object.Get(true)))
+		{
+			Link.Object = *Replacement;
+		}
+	}
+	if (UObject* const* Replacement = ReplacementMap.Find(RootObject.Get(true)))
+	{
+		RootObject = *Replacement;
+	}
+	if (bAnyReplaced)
+	{
+		NotifyGraphChanged();
+	}
+}
+
+void UBrowseGraph::OnReferenceIndexReady()
+{
+	if (bWaitingForReferences)
+	{
+		RefreshGraph(RootObject.Get());
+	}
+}
+
+void UBrowseGraph::ExpandInners(TWeakObjectPtr<UBrowseNode> Node)
+{
+	constexpr int32 ColumnOffset = 900;
+	constexpr int32 RowSpacing = 110;
+
+	UObject* Outer = Node.IsValid() && !Node->IsSummary() ? const_cast<UObject*>(Node->GetUObject()) : nullptr;
+	if (Outer == nullptr)
+	{
+		return;
+	}
+
+	// inners already on the graph, such as the next link of the outer chain, and classes summarized by an earlier expansion
+	TSet<const UObject*> Shown;
+	TSet<const UClass*> Summarized;
+	for (const UEdGraphPin* LinkedPin : Node->GetChildrenPin()->LinkedTo)
+	{
+		const UBrowseNode* ShownNode = Cast<UBrowseNode>(LinkedPin->GetOwningNode());
+		if (ShownNode == nullptr)
+		{
+			continue;
+		}
+		if (ShownNode->IsSummary())
+		{
+			Summarized.Add(ShownNode->GetSummaryClass());
+		}
+		else
+		{
+			Shown.Add(ShownNode->GetUObject());
+		}
+	}
+
+	// counted before anything is made, an outer with thousands of inners is only ever walked
+	TMap<UClass*, int32> ClassCounts;
+	int32 NumInners = 0;
+	ForEachObjectWithOuter(Outer, [&ClassCounts, &NumInners](UObject* Inner)
+	{
+		++ClassCounts.FindOrAdd(Inner->GetClass());
+		++NumInners;
+	}, false);
+
+	// only a starting point, the next layout puts them to the left where their outer pins lead
+	const int32 X = Node->NodePosX - ColumnOffset;
+	int32 Y = Node->NodePosY;
+	if (NumInners <= MaxUngroupedInners)
+	{
+		TArray<UObject*> Inners;
+		GetObjectsWithOuter(Outer, Inners, false);
+		for (UObject* Inner : Inners)
+		{
+			if (!Shown.Contains(Inner))
+			{
+				Node->AddChild(CreateBrowseNode(FIntPoint(X, Y), Inner));
+				Y += RowSpacing;
+			}
+		}
+		return;
+	}
+
+	ClassCounts.ValueSort(TGreater<int32>());
+	for (const TPair<UClass*, int32>& ClassCount : ClassCounts)
+	{
+		if (Summarized.Contains(ClassCount.Key))
+		{
+			continue;
+		}
+		UBrowseNode* SummaryNode = AcquireNode();
+		SummaryNode->SetupSummaryNode(FIntPoint(X, Y), Outer, ClassCount.Key, ClassCount.Value);
+		Node->AddChild(SummaryNode);
+		Y += RowSpacing;
+	}
+}
+
+void UBrowseGraph::ExpandSummary(TWeakObjectPtr<UBrowseNode> SummaryNode)
+{
+	constexpr int32 ColumnOffset = 450;
+	constexpr int32 RowSpacing = 110;
+
+	UObject* Outer = SummaryNode.IsValid() ? SummaryNode->GetSummaryOuter() : nullptr;
+	UClass* InnerClass = SummaryNode.IsValid() ? SummaryNode->GetSummaryClass() : nullptr;
+	if ((Outer == nullptr) || (InnerClass == nullptr) || (SummaryNode->GetNumExpanded() >= SummaryNode->GetNumSummarized()))
+	{
+		return;
+	}
+
+	// the hash iterates in the same order while nothing is added to the outer, so skipping the pages already shown lands on the next one
+	const int32 FirstInner = SummaryNode->GetNumExpanded();
+	int32 NumSeen = 0;
+	TArray<UObject*> Page;
+	ForEachObjectWithOuterBreakable(Outer, [InnerClass, FirstInner, &NumSeen, &Page](UObject* Inner)
+	{
+		if ((Inner->GetClass() == InnerClass) && (NumSeen++ >= FirstInner))
+		{
+			Page.Add(Inner);
+		}
+		return Page.Num() < InnerPageSize;
+	}, false);
+
+	// an inner can already have a node of its own, e.g. the next link of the outer chain, which stays the only one
+	TSet<const UObject*> Shown;
+	for (const UEdGraphNode* GraphNode : Nodes)
+	{
+		const UBrowseNode* ShownNode = Cast<UBrowseNode>(GraphNode);
+		if ((ShownNode != nullptr) && !ShownNode->IsSummary())
+		{
+			Shown.Add(ShownNode->GetUObject());
+		}
+	}
+
+	const int32 X = SummaryNode->NodePosX - ColumnOffset;
+	int32 Y = SummaryNode->NodePosY;
+	for (UObject* Inner : Page)
+	{
+		if (!Shown.Contains(Inner))
+		{
+			SummaryNode->AddChild(CreateBrowseNode(FIntPoint(X, Y), Inner));
+			Y += RowSpacing;
+		}
+	}
+	SummaryNode->SetNumExpanded(Page.Num() > 0 ? FirstInner + Page.Num() : SummaryNode->GetNumSummarized());
+}
+
+void UBrowseGraph::BuildReferenceGraph(UObject* Root)
+{
+	constexpr int32 ColumnSpacing = 450;
+	constexpr int32 RowSpacing = 110;
+
+	UBrowseNode* RootNode = CreateBrowseNode(FIntPoint(0, 0), Root);
+	RootNode->ShowReferencePins();
+
+	TSharedPtr<const FUBrowseReferenceIndex> Index = ReferenceIndex.IsValid() ? ReferenceIndex->Request() : nullptr;
+	if (!Index.IsValid())
+	{
+		// the rest is filled in once the index is ready
+		bWaitingForReferences = ReferenceIndex.IsValid();
+		return;
+	}
+
+	const int32 RootIndex = GUObjectArray.ObjectToIndex(Root);
+	if (!Index->IsGathered(RootIndex))
+	{
+		StatusText = LOCTEXT("ReferencesTooNew", "Created after references were gathered, they are gathered again after the next garbage collection");
+		return;
+	}
+
+	// one side at a time, an object that both references and is referenced by the root shows up on both
+	int32 NumOmitted = 0;
+	for (const bool bReferencers : { true, false })
+	{
+		TMap<int32, UBrowseNode*> SideNodes;
+		SideNodes.Add(RootIndex, RootNode);
+		TSet<int32> Omitted;
+		TArray<int32> Frontier = { RootIndex };
+		for (int32 Depth = 1; (Depth <= ReferenceDepth) && (Frontier.Num() > 0); ++Depth)
+		{
+			TArray<int32> NextFrontier;
+			TArray<UBrowseNode*> Column;
+			for (int32 ObjectIndex : Frontier)
+			{
+				UBrowseNode* FromNode = SideNodes.FindChecked(ObjectIndex);
+				for (int32 NeighbourIndex : bReferencers ? Index->GetReferencers(ObjectIndex) : Index->GetReferences(ObjectIndex))
+				{
+					UBrowseNode* NeighbourNode = SideNodes.FindRef(NeighbourIndex);
+					if (NeighbourNode == nullptr)
+					{
+						UObject* Neighbour = FUBrowseObjectTracker::ResolveObject(NeighbourIndex);
+						if ((Neighbour == nullptr) || !Index->IsGathered(NeighbourIndex))
+						{
+							continue;
+						}
+						if (Column.Num() >= MaxNodesPerColumn)
+						{
+							Omitted.Add(NeighbourIndex);
+							continue;
+						}
+						NeighbourNode = CreateBrowseNode(FIntPoint((bReferencers ? -Depth : Depth) * ColumnSpacing, 0), Neighbour);
+						NeighbourNode->ShowReferencePins();
+						SideNodes.Add(NeighbourIndex, NeighbourNode);
+						Omitted.Remove(NeighbourIndex);
+						NextFrontier.Add(NeighbourIndex);
+						Column.Add(NeighbourNode);
+					}
+					// links always run from the referencer to what it references
+					if (bReferencers)
+					{
+						NeighbourNode->GetReferencesPin()->MakeLinkTo(FromNode->GetReferencersPin());
+					}
+					else
+					{
+						FromNode->GetReferencesPin()->MakeLinkTo(NeighbourNode->GetReferencersPin());
+					}
+				}
+			}
+
+			// centre each column on the root
+			for (int32 Row = 0; Row < Column.Num(); ++Row)
+			{
+				Column[Row]->NodePosY = FMath::RoundToInt((Row - (Column.Num() - 1) * 0.5f) * RowSpacing);
+			}
+			Frontier = MoveTemp(NextFrontier);
+		}
+		NumOmitted += Omitted.Num();
+	}
+	if (NumOmitted > 0)
+	{
+		StatusText = FText::Format(LOCTEXT("OmittedReferences", "{0} more referencers/references not shown"), NumOmitted);
+	}
+}
+
+void UBrowseGraph::BuildWhyAliveGraph(UObject* Root)
+{
+	constexpr int32 ColumnSpacing = 450;
+
+	TSharedPtr<const FUBrowseReferenceIndex> Index = ReferenceIndex.IsValid() ? ReferenceIndex->Request() : nullptr;
+	const int32 RootIndex = GUObjectArray.ObjectToIndex(Root);
+	TArray<int32> Chain;
+	EUBrowseRootReason Reason = EUBrowseRootReason::None;
+	if (!Index.IsValid())
+	{
+		bWaitingForReferences = ReferenceIndex.IsValid();
+	}
+	else if (!Index->IsGathered(RootIndex))
+	{
+		StatusText = LOCTEXT("WhyAliveTooNew", "Created after references were gathered, they are gathered again after the next garbage collection");
+	}
+	else
+	{
+		Reason = Index->FindPathToRoot(RootIndex, Chain);
+	}
+
+	if (Chain.Num() == 0)
+	{
+		CreateBrowseNode(FIntPoint(0, 0), Root)->ShowReferencePins();
+		if ((Index.IsValid()) && StatusText.IsEmpty())
+		{
+			StatusText = LOCTEXT("WhyAliveNothing", "No chain of UObject references leads to a root, the object may still be held by a non UObject referencer such as an FGCObject, a strong pointer or a cluster");
+		}
+		return;
+	}
+
+	// a step freed or reused since the gather breaks the chain there, only the part still reaching the object is shown
+	int32 FirstStep = Chain.Num() - 1;
+	while ((FirstStep > 0) && Index->IsGathered(Chain[FirstStep - 1]) && (FUBrowseObjectTracker::ResolveObject(Chain[FirstStep - 1]) != nullptr))
+	{
+		--FirstStep;
+	}
+
+	// the kept object on the left, each node referencing the one to its right
+	UBrowseNode* PreviousNode = nullptr;
+	for (int32 Step = FirstStep; Step < Chain.Num(); ++Step)
+	{
+		UObject* Object = Step == Chain.Num() - 1 ? Root : FUBrowseObjectTracker::ResolveObject(Chain[Step]);
+		UBrowseNode* Node = CreateBrowseNode(FIntPoint((Step - (Chain.Num() - 1)) * ColumnSpacing, 0), Object);
+		Node->ShowReferencePins();
+		if (PreviousNode != nullptr)
+		{
+			PreviousNode->GetReferencesPin()->MakeLinkTo(Node->GetReferencersPin());
+		}
+		PreviousNode = Node;
+	}
+
+	if (FirstStep > 0)
+	{
+		StatusText = LOCTEXT("WhyAliveStale", "The path to the root changed since references were gathered, they are gathered again after the next garbage collection");
+		return;
+	}
+
+	switch (Reason)
+	{
+	case EUBrowseRootReason::RootSet:
+		StatusText = FText::Format(LOCTEXT("WhyAliveRootSet", "Kept by the root set, {0} references away"), Chain.Num() - 1);
+		break;
+	case EUBrowseRootReason::DisregardForGC:
+		StatusText = FText::Format(LOCTEXT("WhyAliveDisregard", "Kept by the permanent object pool, {0} references away"), Chain.Num() - 1);
+		break;
+	default:
+		StatusText = FText::Format(LOCTEXT("WhyAliveKeepFlags", "Kept by a standalone object, {0} references away"), Chain.Num() - 1);
+		break;
+	}
+}
+
+void UBrowseGraph::BuildOuterGraph(UObject* Root)
+{
+    constexpr int32 nodeYStart = 50;
+    constexpr int32 nodeYSpacing = 150;
 
 	/* Walk the outer chain */
 	TArray<UObject*> Outers;
-	UObject* Root = pRoot == nullptr ? GEngine : pRoot;
 	UObject *Outermost = nullptr;
 	Outermost = Root;
 	while (Outermost != nullptr) 
@@ -35,23 +432,51 @@ void UBrowseGraph::RefreshGraph(UObject* pRoot)
 		Outers.Push(Outermost);
 		Outermost = Outermost->GetOuter();
 	}
-	// start building the graph, outermost first
-	uint32 NodeY = nodeYStart;
 	int32 OuterCount = Outers.Num() - 1;
+
+	// consecutive views usually share the outer chain down to some depth, those nodes and their links stay as they are
+	int32 NumShared = 0;
+	while ((NumShared < OuterChain.Num()) && (NumShared <= OuterCount) && OuterChain[NumShared].Node.IsValid()
+		&& (OuterChain[NumShared].Object.Get() == Outers[OuterCount - NumShared]))
+	{
+		++NumShared;
+	}
+	OuterChain.SetNum(NumShared);
+
+	TSet<const UEdGraphNode*> KeptNodes;
+	for (const FUBrowseOuterLink& Link : OuterChain)
+	{
+		UBrowseNode* ChainNode = Link.Node.Get();
+		KeptNodes.Add(ChainNode);
+		for (UEdGraphPin* Pin : { ChainNode->GetCDOPin(), ChainNode->GetOwnerPin(), ChainNode->GetGeneratedByPin(), ChainNode->GetGeneratesPin() })
+		{
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				KeptNodes.Add(LinkedPin->GetOwningNode());
+			}
+		}
+	}
+	// the rest of the old chain, expanded inners included, goes back to the pool
+	for (UEdGraphNode* Node : TArray<UEdGraphNode*>(Nodes))
+	{
+		if (!KeptNodes.Contains(Node))
+		{
+			ReleaseNode(Node);
+		}
+	}
+
+	// continue building the graph below the shared part, outermost first
+	uint32 NodeY = nodeYStart + NumShared * nodeYSpacing;
 	UBrowseNode*  ThisNode; 
-	UBrowseNode*  PrevNode = nullptr;
+	UBrowseNode*  PrevNode = NumShared > 0 ? OuterChain.Last().Node.Get() : nullptr;
     
-	for (int32 i = OuterCount; i >= 0; i--) {
+	for (int32 i = OuterCount - NumShared; i >= 0; i--) {
 
 	    constexpr int32 nodeXPos = 50;
-        constexpr int32 nodeYSpacing = 150;
 	    
-        FGraphNodeCreator<UBrowseNode> NodeBuilder(*this);
 		UObject *NodeObject = Outers[i];
-		ThisNode = NodeBuilder.CreateNode(false);
-		ThisNode->SetupNode(FIntPoint(nodeXPos, NodeY), NodeObject);
-		ThisNode->FixInPlace();
-		NodeBuilder.Finalize();
+		ThisNode = CreateBrowseNode(FIntPoint(nodeXPos, NodeY), NodeObject);
+		OuterChain.Add({ NodeObject, ThisNode });
 		if (PrevNode != nullptr)
 		{
 			PrevNode->GetChildrenPin()->MakeLinkTo(ThisNode->GetParentPin());
@@ -65,16 +490,10 @@ void UBrowseGraph::RefreshGraph(UObject* pRoot)
 			}
 			if (NodeClass)
 			{
-				TArray<UEdGraphNode*> Siblings;
-				Siblings.Add(ThisNode);
-				FIntRect Bounds = FEdGraphUtilities::CalculateApproximateNodeBoundaries(Siblings);
 				UObject *NodeCDO = NodeClass->ClassDefaultObject;
-				FGraphNodeCreator<UBrowseNode> CDONodeBuilder(*this);
-				auto CDONode = CDONodeBuilder.CreateNode(false);
-				CDONode->SetupNode(FIntPoint(nodeXPos, NodeY), NodeCDO);
+				auto CDONode = CreateBrowseNode(FIntPoint(nodeXPos, NodeY), NodeCDO);
 				CDONode->GetChildrenPin()->PinName = TEXT("Default");
 				ThisNode->GetCDOPin()->MakeLinkTo(CDONode->GetChildrenPin());
-				CDONodeBuilder.Finalize();
 			}
 		}
 		if (!ThisNode->GetOwnerPin()->bHidden)
@@ -85,16 +504,10 @@ void UBrowseGraph::RefreshGraph(UObject* pRoot)
 				AActor* NodeOwner = Component->GetOwner();
 				if (NodeOwner != nullptr)
 				{	
-					TArray<UEdGraphNode*> Siblings;
-					Siblings.Add(ThisNode);
-					FIntRect Bounds = FEdGraphUtilities::CalculateApproximateNodeBoundaries(Siblings);
-					FGraphNodeCreator<UBrowseNode> OwnerNodeBuilder(*this);
-					auto OwnerNode = OwnerNodeBuilder.CreateNode(false);
-					OwnerNode->SetupNode(FIntPoint(nodeXPos, NodeY), NodeOwner);
+					auto OwnerNode = CreateBrowseNode(FIntPoint(nodeXPos, NodeY), NodeOwner);
 					OwnerNode->GetChildrenPin()->PinName = TEXT("Actor");
 					OwnerNode->GetChildrenPin()->Direction = EGPD_Output;
 					OwnerNode->GetChildrenPin()->MakeLinkTo(ThisNode->GetOwnerPin());
-					OwnerNodeBuilder.Finalize();
 				}
 			}
 		}
@@ -103,17 +516,11 @@ void UBrowseGraph::RefreshGraph(UObject* pRoot)
 			UBlueprintGeneratedClass *NodeBPClass = Cast<UBlueprintGeneratedClass>(NodeObject);
 			if (NodeBPClass)
 			{
-				TArray<UEdGraphNode*> Siblings;
-				Siblings.Add(ThisNode);
-				FIntRect Bounds = FEdGraphUtilities::CalculateApproximateNodeBoundaries(Siblings);
 				UObject* BP = NodeBPClass->ClassGeneratedBy;
-				FGraphNodeCreator<UBrowseNode> BPNodeBuilder(*this);
-				auto BPNode = BPNodeBuilder.CreateNode(false);
-				BPNode->SetupNode(FIntPoint(nodeXPos, NodeY), BP);
+				auto BPNode = CreateBrowseNode(FIntPoint(nodeXPos, NodeY), BP);
 				ThisNode->GetGeneratedByPin()->Direction = EGPD_Input;
 				BPNode->GetGeneratesPin()->Direction = EGPD_Output;
 				ThisNode->GetGeneratedByPin()->MakeLinkTo(BPNode->GetGeneratesPin());
-				BPNodeBuilder.Finalize();
 			}
 		}
 		if (!ThisNode->GetGeneratesPin()->bHidden)
@@ -121,20 +528,14 @@ void UBrowseGraph::RefreshGraph(UObject* pRoot)
 			UBlueprint* BP = Cast<UBlueprint>(NodeObject);
 			if (BP)
 			{
-				TArray<UEdGraphNode*> Siblings;
-				Siblings.Add(ThisNode);
-				FIntRect Bounds = FEdGraphUtilities::CalculateApproximateNodeBoundaries(Siblings);
 				UClass* GeneratedClass = BP->GeneratedClass.Get();
-				FGraphNodeCreator<UBrowseNode> GeneratedNodeBuilder(*this);
-				auto GeneratedNode = GeneratedNodeBuilder.CreateNode(false);
-				GeneratedNode->SetupNode(FIntPoint(nodeXPos, NodeY), GeneratedClass);
+				auto GeneratedNode = CreateBrowseNode(FIntPoint(nodeXPos, NodeY), GeneratedClass);
 				if (GeneratedNode->GetGeneratedByPin() != nullptr)
 				{
 					ThisNode->GetGeneratesPin()->Direction = EGPD_Output;
 					GeneratedNode->GetGeneratedByPin()->Direction = EGPD_Input;
 					ThisNode->GetGeneratesPin()->MakeLinkTo(GeneratedNode->GetGeneratedByPin());
 				}
-				GeneratedNodeBuilder.Finalize();
 			}
 		}
 
@@ -143,13 +544,96 @@ void UBrowseGraph::RefreshGraph(UObject* pRoot)
 	}
 }
 
+void UBrowseGraph::LayoutNodes(TFunctionRef<FVector2D(const UEdGraphNode*)> GetNodeSize)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_LayoutNodes);
+
+	bLayoutDirty = false;
+
+	TMap<const UEdGraphNode*, int32> NodeIndices;
+	NodeIndices.Reserve(Nodes.Num());
+	TArray<FVector2D> Sizes;
+	Sizes.Reserve(Nodes.Num());
+	for (const UEdGraphNode* Node : Nodes)
+	{
+		NodeIndices.Add(Node, Sizes.Num());
+		Sizes.Add(GetNodeSize(Node));
+	}
+
+	// every link runs from an output pin on the right of one node to an input pin on the left of another
+	TArray<TPair<int32, int32>> Edges;
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		for (const UEdGraphPin* Pin : Nodes[NodeIndex]->Pins)
+		{
+			if (Pin->Direction != EGPD_Output)
+			{
+				continue;
+			}
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (const int32* LinkedIndex = NodeIndices.Find(LinkedPin->GetOwningNode()))
+				{
+					Edges.Emplace(NodeIndex, *LinkedIndex);
+				}
+			}
+		}
+	}
+
+	TArray<FVector2D> Positions;
+	FUBrowseGraphLayout::Compute(Sizes, Edges, Positions);
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		Nodes[NodeIndex]->NodePosX = FMath::RoundToInt(Positions[NodeIndex].X);
+		Nodes[NodeIndex]->NodePosY = FMath::RoundToInt(Positions[NodeIndex].Y);
+	}
+}
+
+UBrowseNode* UBrowseGraph::CreateBrowseNode(const FIntPoint& Position, UObject* Object)
+{
+	UBrowseNode* Node = AcquireNode();
+	Node->SetupNode(Position, Object);
+	return Node;
+}
+
+UBrowseNode* UBrowseGraph::AcquireNode()
+{
+	UBrowseNode* Node = nullptr;
+	if (NodePool.Num() > 0)
+	{
+		Node = NodePool.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Node = NewObject<UBrowseNode>(this);
+		Node->SetFlags(RF_Transactional);
+	}
+	AddNode(Node, false, false);
+	Node->CreateNewGuid();
+	bLayoutDirty = true;
+	return Node;
+}
+
+void UBrowseGraph::ReleaseNode(UEdGraphNode* Node)
+{
+	RemoveNode(Node);
+	bLayoutDirty = true;
+	UBrowseNode* BrowseNode = Cast<UBrowseNode>(Node);
+	if ((BrowseNode != nullptr) && (NodePool.Num() < MaxPooledNodes))
+	{
+		BrowseNode->ResetForReuse();
+		NodePool.Add(BrowseNode);
+	}
+}
+
 void UBrowseGraph::RemoveAllNodes()
 {
 	TArray< UEdGraphNode* > NodesToRemove = Nodes;
 	for (int32 NodeIndex = 0; NodeIndex < NodesToRemove.Num(); ++NodeIndex)
 	{
-		RemoveNode(NodesToRemove[NodeIndex]);
+		ReleaseNode(NodesToRemove[NodeIndex]);
 	}
+	OuterChain.Reset();
 }
 
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
+#undef LOCTEXT_NAMESPACE
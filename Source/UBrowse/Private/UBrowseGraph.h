@@ -6,16 +6,129 @@
 
 #include "UBrowseGraph.generated.h"
 
+class FUBrowseReferenceIndexCache;
+class UBrowseNode;
+
+/* A node of the outer chain and the object it was made for */
+struct FUBrowseOuterLink
+{
+    TWeakObjectPtr<UObject> Object;
+    TWeakObjectPtr<UBrowseNode> Node;
+};
+
+/* What the graph shows around the object being browsed */
+enum class EUBrowseGraphMode : uint8
+{
+    /* The outer chain, with CDO, owner and blueprint links */
+    Outers,
+    /* Referencers to the left, references to the right */
+    References,
+    /* The shortest chain of references from an object garbage collection keeps */
+    WhyAlive
+};
 
 UCLASS()
 class UBrowseGraph : public UEdGraph
 {
     GENERATED_UCLASS_BODY()
   public:
+    //~ Begin UObject Interface
+    virtual void BeginDestroy() override;
+    //~ End UObject Interface
+
     // Build the graph based on the current object
     void RefreshGraph(UObject* object = nullptr);
 
+    /* Source of the reference graph, shared with whoever else needs references */
+    void SetReferenceIndex(TSharedPtr<FUBrowseReferenceIndexCache> InReferenceIndex);
+
+    EUBrowseGraphMode GetMode() const { return Mode; }
+
+    /* Switch mode and rebuild around the same object */
+    void SetMode(EUBrowseGraphMode InMode);
+
+    int32 GetReferenceDepth() const { return ReferenceDepth; }
+
+    /* How many reference hops the reference graph follows each way */
+    void SetReferenceDepth(int32 InDepth);
+
+    /* Explain what keeps an object from being garbage collected */
+    void ShowWhyAlive(TWeakObjectPtr<UObject> Object);
+
+    /* True while the reference or why alive graph waits for the index to be built */
+    bool IsWaitingForReferences() const { return bWaitingForReferences; }
+
+    /* What the last reference or why alive graph left out or found, empty if nothing to say */
+    const FText& GetStatusText() const { return StatusText; }
+
+    /* Most nodes in one column of the reference graph */
+    static constexpr int32 MaxNodesPerColumn = 40;
+
+    /* Inners given their own nodes per expansion of a summary node */
+    static constexpr int32 InnerPageSize = 25;
+
+    /* Outers with more inners than this show one summary node per inner class instead */
+    static constexpr int32 MaxUngroupedInners = 50;
+
+    /* Show the inners of a node's object to its left, as per class summary nodes when there are many */
+    void ExpandInners(TWeakObjectPtr<UBrowseNode> Node);
+
+    /* Give the next page of a summary node's inners nodes of their own */
+    void ExpandSummary(TWeakObjectPtr<UBrowseNode> SummaryNode);
+
+    /* True once nodes were added or removed or grew since the last layout */
+    bool IsLayoutDirty() const { return bLayoutDirty; }
+
+    /* Ask for a new layout without the graph changing, for node widgets that changed size */
+    void MarkLayoutDirty() { bLayoutDirty = true; }
+
+    /* Place every node in layers along its links, from the sizes the node widgets came out at */
+    void LayoutNodes(TFunctionRef<FVector2D(const UEdGraphNode*)> GetNodeSize);
+
    private:
     // Clear the graph
     void RemoveAllNodes();
-};
\ No newline at end of file
+
+    void BuildOuterGraph(UObject* Root);
+
+    void BuildReferenceGraph(UObject* Root);
+
+    void BuildWhyAliveGraph(UObject* Root);
+
+    UBrowseNode* CreateBrowseNode(const FIntPoint& Position, UObject* Object);
+
+    /* A node from the pool, or a new one when it is empty, added to the graph but not set up */
+    UBrowseNode* AcquireNode();
+
+    /* Take a node off the graph and keep it for reuse */
+    void ReleaseNode(UEdGraphNode* Node);
+
+    void OnReferenceIndexReady();
+
+    /* Retarget the nodes of reinstanced objects and refresh what they show */
+    void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+    TWeakObjectPtr<UObject> RootObject;
+
+    EUBrowseGraphMode Mode = EUBrowseGraphMode::Outers;
+
+    int32 ReferenceDepth = 1;
+
+    bool bWaitingForReferences = false;
+
+    bool bLayoutDirty = false;
+
+    FText StatusText;
+
+    TSharedPtr<FUBrowseReferenceIndexCache> ReferenceIndex;
+
+    /* Nodes of the outer chain on the graph, outermost first. Empty when the graph shows another mode */
+    TArray<FUBrowseOuterLink> OuterChain;
+
+    /* Released nodes, reset and waiting to be set up again */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UBrowseNode>> NodePool;
+
+    /* Most released nodes kept, the rest are left to garbage collection */
+    static constexpr int32 MaxPooledNodes = 256;
+};
@@ -0,0 +1,348 @@
+#include "UBrowseGraphLayout.h"
+#include "UBrowseStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Graph Layout"), STAT_UBrowse_GraphLayout, STATGROUP_UBrowse);
+
+namespace
+{
+	/* A node, or a placeholder where an edge passes through a layer */
+	struct FLayoutVertex
+	{
+		FVector2D Size = FVector2D::ZeroVector;
+		int32 Layer = 0;
+		/* Position within the layer */
+		int32 Order = 0;
+		float Barycenter = 0.0f;
+		double Y = 0.0;
+		TArray<int32, TInlineAllocator<4>> Predecessors;
+		TArray<int32, TInlineAllocator<4>> Successors;
+	};
+
+	/* Sort a layer by the mean order of each vertex's neighbours on one side, those without any keep their place */
+	void OrderByBarycenter(TArray<FLayoutVertex>& Vertices, TArray<int32>& LayerVertices, bool bByPredecessors)
+	{
+		for (int32 VertexIndex : LayerVertices)
+		{
+			FLayoutVertex& Vertex = Vertices[VertexIndex];
+			const TArray<int32, TInlineAllocator<4>>& Neighbours = bByPredecessors ? Vertex.Predecessors : Vertex.Successors;
+			if (Neighbours.Num() == 0)
+			{
+				Vertex.Barycenter = Vertex.Order;
+				continue;
+			}
+			int32 OrderSum = 0;
+			for (int32 Neighbour : Neighbours)
+			{
+				OrderSum += Vertices[Neighbour].Order;
+			}
+			Vertex.Barycenter = float(OrderSum) / Neighbours.Num();
+		}
+
+		LayerVertices.StableSort([&Vertices](int32 A, int32 B) { return Vertices[A].Barycenter < Vertices[B].Barycenter; });
+		for (int32 Order = 0; Order < LayerVertices.Num(); ++Order)
+		{
+			Vertices[LayerVertices[Order]].Order = Order;
+		}
+	}
+
+	/* Edges between consecutive layers that cross, every edge runs between consecutive layers once placeholders are in */
+	int32 CountCrossings(const TArray<FLayoutVertex>& Vertices, const TArray<TArray<int32>>& Layers)
+	{
+		int32 NumCrossings = 0;
+		TArray<TPair<int32, int32>> LayerEdges;
+		for (int32 Layer = 0; Layer + 1 < Layers.Num(); ++Layer)
+		{
+			LayerEdges.Reset();
+			for (int32 VertexIndex : Layers[Layer])
+			{
+				for (int32 Successor : Vertices[VertexIndex].Successors)
+				{
+					LayerEdges.Emplace(Vertices[VertexIndex].Order, Vertices[Successor].Order);
+				}
+			}
+
+			// ordered by where the edges start, two cross when their ends come in the opposite order
+			LayerEdges.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) { return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value; });
+			for (int32 First = 0; First < LayerEdges.Num(); ++First)
+			{
+				for (int32 Second = First + 1; Second < LayerEdges.Num(); ++Second)
+				{
+					NumCrossings += LayerEdges[Second].Value < LayerEdges[First].Value ? 1 : 0;
+				}
+			}
+		}
+		return NumCrossings;
+	}
+
+	/* Move a layer towards the mean centre of each vertex's neighbours on one side, keeping its order and spacing */
+	void PullTowardsNeighbours(TArray<FLayoutVertex>& Vertices, const TArray<int32>& LayerVertices, bool bByPredecessors, float NodeGap)
+	{
+		TArray<double, TInlineAllocator<64>> Desired;
+		Desired.SetNumUninitialized(LayerVertices.Num());
+		for (int32 Order = 0; Order < LayerVertices.Num(); ++Order)
+		{
+			const FLayoutVertex& Vertex = Vertices[LayerVertices[Order]];
+			const TArray<int32, TInlineAllocator<4>>& Neighbours = bByPredecessors ? Vertex.Predecessors : Vertex.Successors;
+			if (Neighbours.Num() == 0)
+			{
+				Desired[Order] = Vertex.Y;
+				continue;
+			}
+			double CentreSum = 0.0;
+			for (int32 Neighbour : Neighbours)
+			{
+				CentreSum += Vertices[Neighbour].Y + Vertices[Neighbour].Size.Y * 0.5;
+			}
+			Desired[Order] = CentreSum / Neighbours.Num() - Vertex.Size.Y * 0.5;
+		}
+
+		// pushed down wherever the one above is in the way, then the whole layer moved to make up for the pushing on average
+		double Shift = 0.0;
+		for (int32 Order = 0; Order < LayerVertices.Num(); ++Order)
+		{
+			FLayoutVertex& Vertex = Vertices[LayerVertices[Order]];
+			Vertex.Y = Desired[Order];
+			if (Order > 0)
+			{
+				const FLayoutVertex& Above = Vertices[LayerVertices[Order - 1]];
+				Vertex.Y = FMath::Max(Vertex.Y, Above.Y + Above.Size.Y + NodeGap);
+			}
+			Shift += Desired[Order] - Vertex.Y;
+		}
+		Shift /= FMath::Max(LayerVertices.Num(), 1);
+		for (int32 VertexIndex : LayerVertices)
+		{
+			Vertices[VertexIndex].Y += Shift;
+		}
+	}
+}
+
+void FUBrowseGraphLayout::Compute(TConstArrayView<FVector2D> Sizes, TConstArrayView<TPair<int32, int32>> Edges, TArray<FVector2D>& OutPositions, const FSettings& Settings)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_GraphLayout);
+
+	const int32 NumNodes = Sizes.Num();
+	OutPositions.SetNumZeroed(NumNodes);
+	if (NumNodes == 0)
+	{
+		return;
+	}
+
+	TArray<TArray<int32>> Successors;
+	Successors.SetNum(NumNodes);
+	for (const TPair<int32, int32>& Edge : Edges)
+	{
+		if ((Edge.Key != Edge.Value) && Sizes.IsValidIndex(Edge.Key) && Sizes.IsValidIndex(Edge.Value))
+		{
+			Successors[Edge.Key].AddUnique(Edge.Value);
+		}
+	}
+
+	// a depth first walk turns around every edge leading back onto its own path, which leaves no cycles
+	{
+		enum : uint8 { Unvisited, OnPath, Done };
+		TArray<uint8> VisitState;
+		VisitState.SetNumZeroed(NumNodes);
+		TArray<TPair<int32, int32>> BackEdges;
+		/* Node on the path and the next of its successors to visit */
+		TArray<TPair<int32, int32>> Path;
+		for (int32 Start = 0; Start < NumNodes; ++Start)
+		{
+			if (VisitState[Start] != Unvisited)
+			{
+				continue;
+			}
+			VisitState[Start] = OnPath;
+			Path.Emplace(Start, 0);
+			while (Path.Num() > 0)
+			{
+				const int32 Node = Path.Last().Key;
+				if (Path.Last().Value == Successors[Node].Num())
+				{
+					VisitState[Node] = Done;
+					Path.Pop(EAllowShrinking::No);
+					continue;
+				}
+				const int32 Next = Successors[Node][Path.Last().Value++];
+				if (VisitState[Next] == OnPath)
+				{
+					BackEdges.Emplace(Node, Next);
+				}
+				else if (VisitState[Next] == Unvisited)
+				{
+					VisitState[Next] = OnPath;
+					Path.Emplace(Next, 0);
+				}
+			}
+		}
+		for (const TPair<int32, int32>& BackEdge : BackEdges)
+		{
+			Successors[BackEdge.Key].RemoveSingleSwap(BackEdge.Value, EAllowShrinking::No);
+			Successors[BackEdge.Value].AddUnique(BackEdge.Key);
+		}
+	}
+
+	// each node one layer past the longest path leading to it
+	TArray<int32> Layers;
+	Layers.SetNumZeroed(NumNodes);
+	{
+		TArray<int32> NumUnplacedPredecessors;
+		NumUnplacedPredecessors.SetNumZeroed(NumNodes);
+		for (const TArray<int32>& NodeSuccessors : Successors)
+		{
+			for (int32 Successor : NodeSuccessors)
+			{
+				++NumUnplacedPredecessors[Successor];
+			}
+		}
+		TArray<int32> TopologicalOrder;
+		TopologicalOrder.Reserve(NumNodes);
+		for (int32 Node = 0; Node < NumNodes; ++Node)
+		{
+			if (NumUnplacedPredecessors[Node] == 0)
+			{
+				TopologicalOrder.Add(Node);
+			}
+		}
+		for (int32 Head = 0; Head < TopologicalOrder.Num(); ++Head)
+		{
+			const int32 Node = TopologicalOrder[Head];
+			for (int32 Successor : Successors[Node])
+			{
+				Layers[Successor] = FMath::Max(Layers[Successor], Layers[Node] + 1);
+				if (--NumUnplacedPredecessors[Successor] == 0)
+				{
+					TopologicalOrder.Add(Successor);
+				}
+			}
+		}
+
+		// nodes nothing leads to would all sit in the first layer, they go next to what they lead to instead
+		TArray<bool> bHasPredecessors;
+		bHasPredecessors.SetNumZeroed(NumNodes);
+		for (const TArray<int32>& NodeSuccessors : Successors)
+		{
+			for (int32 Successor : NodeSuccessors)
+			{
+				bHasPredecessors[Successor] = true;
+			}
+		}
+		for (int32 Node = 0; Node < NumNodes; ++Node)
+		{
+			if (!bHasPredecessors[Node] && (Successors[Node].Num() > 0))
+			{
+				int32 FirstSuccessorLayer = MAX_int32;
+				for (int32 Successor : Successors[Node])
+				{
+					FirstSuccessorLayer = FMath::Min(FirstSuccessorLayer, Layers[Successor]);
+				}
+				Layers[Node] = FirstSuccessorLayer - 1;
+			}
+		}
+	}
+
+	// edges spanning several layers pass through a placeholder in each layer in between
+	TArray<FLayoutVertex> Vertices;
+	Vertices.SetNum(NumNodes);
+	int32 NumLayers = 0;
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		Vertices[Node].Size = Sizes[Node];
+		Vertices[Node].Layer = Layers[Node];
+		NumLayers = FMath::Max(NumLayers, Layers[Node] + 1);
+	}
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		for (int32 Successor : Successors[Node])
+		{
+			int32 Previous = Node;
+			for (int32 Layer = Layers[Node] + 1; Layer < Layers[Successor]; ++Layer)
+			{
+				const int32 Placeholder = Vertices.AddDefaulted();
+				Vertices[Placeholder].Layer = Layer;
+				Vertices[Previous].Successors.Add(Placeholder);
+				Vertices[Placeholder].Predecessors.Add(Previous);
+				Previous = Placeholder;
+			}
+			Vertices[Previous].Successors.Add(Successor);
+			Vertices[Successor].Predecessors.Add(Previous);
+		}
+	}
+
+	// start from the order the nodes came in, sweep back and forth and keep the order with the fewest crossings
+	TArray<TArray<int32>> LayerVertices;
+	LayerVertices.SetNum(NumLayers);
+	for (int32 VertexIndex = 0; VertexIndex < Vertices.Num(); ++VertexIndex)
+	{
+		FLayoutVertex& Vertex = Vertices[VertexIndex];
+		Vertex.Order = LayerVertices[Vertex.Layer].Add(VertexIndex);
+	}
+
+	TArray<TArray<int32>> BestLayerVertices = LayerVertices;
+	int32 BestNumCrossings = CountCrossings(Vertices, LayerVertices);
+	for (int32 Sweep = 0; (Sweep < Settings.NumOrderingSweeps) && (BestNumCrossings > 0); ++Sweep)
+	{
+		for (int32 Layer = 1; Layer < NumLayers; ++Layer)
+		{
+			OrderByBarycenter(Vertices, LayerVertices[Layer], true);
+		}
+		for (int32 Layer = NumLayers - 2; Layer >= 0; --Layer)
+		{
+			OrderByBarycenter(Vertices, LayerVertices[Layer], false);
+		}
+
+		const int32 NumCrossings = CountCrossings(Vertices, LayerVertices);
+		if (NumCrossings < BestNumCrossings)
+		{
+			BestNumCrossings = NumCrossings;
+			BestLayerVertices = LayerVertices;
+		}
+	}
+	LayerVertices = MoveTemp(BestLayerVertices);
+	for (const TArray<int32>& Layer : LayerVertices)
+	{
+		for (int32 Order = 0; Order < Layer.Num(); ++Order)
+		{
+			Vertices[Layer[Order]].Order = Order;
+		}
+	}
+
+	// layers stacked and centred on the same line, then pulled towards their neighbours a few times
+	TArray<double> LayerX;
+	LayerX.SetNumZeroed(NumLayers);
+	double NextLayerX = 0.0;
+	for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		LayerX[Layer] = NextLayerX;
+		double LayerWidth = 0.0;
+		double LayerHeight = 0.0;
+		for (int32 VertexIndex : LayerVertices[Layer])
+		{
+			FLayoutVertex& Vertex = Vertices[VertexIndex];
+			Vertex.Y = LayerHeight;
+			LayerHeight += Vertex.Size.Y + Settings.NodeGap;
+			LayerWidth = FMath::Max(LayerWidth, Vertex.Size.X);
+		}
+		for (int32 VertexIndex : LayerVertices[Layer])
+		{
+			Vertices[VertexIndex].Y -= LayerHeight * 0.5;
+		}
+		NextLayerX += LayerWidth + Settings.LayerGap;
+	}
+	for (int32 Sweep = 0; Sweep < Settings.NumPositionSweeps; ++Sweep)
+	{
+		for (int32 Layer = 1; Layer < NumLayers; ++Layer)
+		{
+			PullTowardsNeighbours(Vertices, LayerVertices[Layer], true, Settings.NodeGap);
+		}
+		for (int32 Layer = NumLayers - 2; Layer >= 0; --Layer)
+		{
+			PullTowardsNeighbours(Vertices, LayerVertices[Layer], false, Settings.NodeGap);
+		}
+	}
+
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		OutPositions[Node] = FVector2D(LayerX[Vertices[Node].Layer], Vertices[Node].Y);
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Layered (Sugiyama style) graph layout. Edges run left to right from layer to layer: cycles are broken
+ * by turning edges around, nodes get the layer of their longest incoming path, edges spanning several
+ * layers are routed through placeholder vertices, the order within each layer is swept by barycenters to
+ * cut crossings, and coordinates are packed from the node sizes so nothing overlaps.
+ */
+class FUBrowseGraphLayout
+{
+public:
+	struct FSettings
+	{
+		/* Horizontal space between the widest nodes of two layers */
+		float LayerGap = 100.0f;
+		/* Vertical space between two nodes of a layer */
+		float NodeGap = 30.0f;
+		/* Down and up passes of the crossing reduction */
+		int32 NumOrderingSweeps = 6;
+		/* Passes pulling nodes towards their neighbours once the order is settled */
+		int32 NumPositionSweeps = 4;
+	};
+
+	/**
+	 * @param Sizes        Size of each node
+	 * @param Edges        Node index pairs, the first ends up left of the second unless that would close a cycle
+	 * @param OutPositions Receives the top left corner of each node
+	 */
+	static void Compute(TConstArrayView<FVector2D> Sizes, TConstArrayView<TPair<int32, int32>> Edges, TArray<FVector2D>& OutPositions, const FSettings& Settings = FSettings());
+};
@@ -0,0 +1,47 @@
+#include "UBrowseListDelta.h"
+#include "UBrowseStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("List Delta"), STAT_UBrowse_ListDelta, STATGROUP_UBrowse);
+
+FUBrowseListDelta FUBrowseListDelta::Compute(const FUBrowseObjectRows& Previous, const FUBrowseObjectRows& Current, TArrayView<const FUBrowseSortColumn> Columns, int32 AnchorIndex)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_ListDelta);
+
+	FUBrowseListDelta Delta;
+
+	int32 PreviousRow = 0;
+	int32 CurrentRow = 0;
+	while ((PreviousRow < Previous.Num()) || (CurrentRow < Current.Num()))
+	{
+		if ((PreviousRow == AnchorIndex) && (Delta.NewAnchorIndex == INDEX_NONE))
+		{
+			Delta.NewAnchorIndex = CurrentRow;
+		}
+
+		if ((PreviousRow < Previous.Num()) && (CurrentRow < Current.Num()) && (Previous.Handles[PreviousRow] == Current.Handles[CurrentRow]))
+		{
+			++PreviousRow;
+			++CurrentRow;
+			continue;
+		}
+
+		// on a tie the old row goes first, a reused slot compares equal to the object it replaced
+		const bool bTakePrevious = (CurrentRow >= Current.Num())
+			|| ((PreviousRow < Previous.Num()) && (FUBrowseObjectSorter::CompareRows(Previous, PreviousRow, Current, CurrentRow, Columns) <= 0));
+		if (bTakePrevious)
+		{
+			++PreviousRow;
+			++Delta.NumRemoved;
+		}
+		else
+		{
+			++CurrentRow;
+			++Delta.NumInserted;
+		}
+	}
+	if ((AnchorIndex != INDEX_NONE) && (Delta.NewAnchorIndex == INDEX_NONE))
+	{
+		Delta.NewAnchorIndex = Current.Num();
+	}
+	return Delta;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "UBrowseObjectRows.h"
+#include "UBrowseObjectSort.h"
+
+/**
+ * What changed between two publications of the sorted object list.
+ *
+ * Both lists are walked in step like the merge of a merge sort, so the cost is one comparison per row
+ * and nothing is allocated. A row whose sort values changed in between shows up as removed at its old
+ * position and inserted at its new one.
+ */
+struct FUBrowseListDelta
+{
+	int32 NumInserted = 0;
+	int32 NumRemoved = 0;
+
+	/* Index in the new list of the old row at the anchor index, or of the row that took its place if it was removed */
+	int32 NewAnchorIndex = INDEX_NONE;
+
+	bool IsEmpty() const { return (NumInserted == 0) && (NumRemoved == 0); }
+
+	/**
+	 * Diff two row lists sorted by the same columns.
+	 *
+	 * @param Previous    The rows currently published
+	 * @param Current     The rows about to replace them
+	 * @param Columns     The columns both lists are sorted by
+	 * @param AnchorIndex Row of Previous to map into Current, INDEX_NONE for none
+	 */
+	static FUBrowseListDelta Compute(const FUBrowseObjectRows& Previous, const FUBrowseObjectRows& Current, TArrayView<const FUBrowseSortColumn> Columns, int32 AnchorIndex = INDEX_NONE);
+};
@@ -0,0 +1,323 @@
+#include "UBrowseNameIndex.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectBase.h"
+#include "UBrowseStats.h"
+
+namespace
+{
+	/* Objects are indexed even while they are still loading, their name is set before their slot is handed out */
+	UObjectBase* GetIndexedObject(int32 ObjectIndex)
+	{
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+		if ((ObjectItem == nullptr) || ObjectItem->HasAnyFlags(EInternalObjectFlags::Unreachable))
+		{
+			return nullptr;
+		}
+		return ObjectItem->GetObject();
+	}
+}
+
+FUBrowseNameIndex::FUBrowseNameIndex()
+{
+	FCoreUObjectDelegates::OnObjectRenamed.AddRaw(this, &FUBrowseNameIndex::OnObjectRenamed);
+}
+
+FUBrowseNameIndex::~FUBrowseNameIndex()
+{
+	FCoreUObjectDelegates::OnObjectRenamed.RemoveAll(this);
+	Tracker.StopTracking();
+}
+
+DECLARE_CYCLE_STAT(TEXT("Name Index Rebuild"), STAT_UBrowse_NameIndexRebuild, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Name Index Update"), STAT_UBrowse_NameIndexUpdate, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Name Index Query"), STAT_UBrowse_NameIndexQuery, STATGROUP_UBrowse);
+
+void FUBrowseNameIndex::Rebuild()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_NameIndexRebuild);
+
+	NameSlots.Reset();
+	SlotNames.Reset();
+	SlotNameIds.Reset();
+	SlotObjects.Reset();
+	TrigramSlots.Reset();
+
+	// start listening before the scan, anything created during it is de-duplicated through ObjectSlots
+	Tracker.StartTracking();
+	Tracker.Reset();
+	{
+		FScopeLock Lock(&RenamedLock);
+		RenamedIndices.Reset();
+	}
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	ObjectSlots.Init(INDEX_NONE, NumObjects);
+	ObjectPositions.SetNumUninitialized(NumObjects);
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		IndexObject(ObjectIndex);
+	}
+
+	bValid = true;
+}
+
+void FUBrowseNameIndex::Update()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_NameIndexUpdate);
+
+	if (!bValid)
+	{
+		Rebuild();
+		return;
+	}
+
+	TArray<int32> CreatedIndices;
+	TArray<int32> DeletedIndices;
+	if (!Tracker.ConsumeChanges(CreatedIndices, DeletedIndices))
+	{
+		Rebuild();
+		return;
+	}
+
+	for (int32 ObjectIndex : DeletedIndices)
+	{
+		UnindexObject(ObjectIndex);
+	}
+
+	for (int32 ObjectIndex : CreatedIndices)
+	{
+		IndexObject(ObjectIndex);
+	}
+
+	TArray<int32> Renamed;
+	{
+		FScopeLock Lock(&RenamedLock);
+		Renamed = MoveTemp(RenamedIndices);
+		RenamedIndices.Reset();
+	}
+	for (int32 ObjectIndex : Renamed)
+	{
+		UnindexObject(ObjectIndex);
+		IndexObject(ObjectIndex);
+	}
+}
+
+bool FUBrowseNameIndex::CanQuery(const FString& Substring)
+{
+	for (TCHAR Char : Substring)
+	{
+		if (!FChar::IsDigit(Char))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FUBrowseNameIndex::Query(const FString& Substring, TArray<int32>& OutObjectIndices) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_NameIndexQuery);
+
+	const FString Needle = Substring.ToLower();
+
+	TArray<int32> Slots;
+	FindCandidateSlots(Needle, Slots);
+	for (int32 Slot : Slots)
+	{
+		if (!SlotNames[Slot].Contains(Needle, ESearchCase::CaseSensitive))
+		{
+			continue;
+		}
+		// matched on the base name alone, so every object still carrying the name matches whatever its number
+		const FNameEntryId NameId = SlotNameIds[Slot];
+		for (int32 ObjectIndex : SlotObjects[Slot])
+		{
+			const UObjectBase* Object = GetIndexedObject(ObjectIndex);
+			if ((Object != nullptr) && (Object->GetFName().GetComparisonIndex() == NameId))
+			{
+				OutObjectIndices.Add(ObjectIndex);
+			}
+		}
+	}
+
+	// a match can also run on into the number suffix, "mesh_1" is found in "StaticMesh_12"
+	int32 UnderscoreIndex = INDEX_NONE;
+	if (!Needle.FindLastChar(TEXT('_'), UnderscoreIndex))
+	{
+		return;
+	}
+	for (int32 CharIndex = UnderscoreIndex + 1; CharIndex < Needle.Len(); ++CharIndex)
+	{
+		if (!FChar::IsDigit(Needle[CharIndex]))
+		{
+			return;
+		}
+	}
+
+	const FString Prefix = Needle.Left(UnderscoreIndex);
+	FindCandidateSlots(Prefix, Slots);
+	for (int32 Slot : Slots)
+	{
+		const FString& SlotName = SlotNames[Slot];
+		if (!SlotName.EndsWith(Prefix, ESearchCase::CaseSensitive) || SlotName.Contains(Needle, ESearchCase::CaseSensitive))
+		{
+			// either cannot match across the suffix or was already added whole above
+			continue;
+		}
+		const FNameEntryId NameId = SlotNameIds[Slot];
+		for (int32 ObjectIndex : SlotObjects[Slot])
+		{
+			const UObjectBase* Object = GetIndexedObject(ObjectIndex);
+			if (Object == nullptr)
+			{
+				continue;
+			}
+			const FName ObjectName = Object->GetFName();
+			if ((ObjectName.GetComparisonIndex() == NameId) && (ObjectName.GetNumber() != NAME_NO_NUMBER_INTERNAL) && ObjectName.ToString().Contains(Needle))
+			{
+				OutObjectIndices.Add(ObjectIndex);
+			}
+		}
+	}
+}
+
+uint64 FUBrowseNameIndex::MakeTrigram(TCHAR A, TCHAR B, TCHAR C)
+{
+	constexpr uint64 CharMask = 0x1FFFFF;
+	return ((uint64(A) & CharMask) << 42) | ((uint64(B) & CharMask) << 21) | (uint64(C) & CharMask);
+}
+
+void FUBrowseNameIndex::GetTrigrams(const FString& FoldedText, TArray<uint64>& OutTrigrams)
+{
+	OutTrigrams.Reset();
+	for (int32 CharIndex = 0; CharIndex + 2 < FoldedText.Len(); ++CharIndex)
+	{
+		OutTrigrams.AddUnique(MakeTrigram(FoldedText[CharIndex], FoldedText[CharIndex + 1], FoldedText[CharIndex + 2]));
+	}
+}
+
+int32 FUBrowseNameIndex::FindOrAddNameSlot(FNameEntryId NameId)
+{
+	if (const int32* ExistingSlot = NameSlots.Find(NameId))
+	{
+		return *ExistingSlot;
+	}
+
+	const int32 Slot = SlotNames.Add(FName::CreateFromDisplayId(NameId, NAME_NO_NUMBER_INTERNAL).ToString().ToLower());
+	SlotNameIds.Add(NameId);
+	SlotObjects.AddDefaulted();
+	NameSlots.Add(NameId, Slot);
+
+	// new slots are always the highest, appending keeps the posting lists sorted
+	TArray<uint64> Trigrams;
+	GetTrigrams(SlotNames[Slot], Trigrams);
+	for (uint64 Trigram : Trigrams)
+	{
+		TrigramSlots.FindOrAdd(Trigram).Add(Slot);
+	}
+	return Slot;
+}
+
+void FUBrowseNameIndex::IndexObject(int32 ObjectIndex)
+{
+	if (ObjectIndex >= ObjectSlots.Num())
+	{
+		const int32 OldNum = ObjectSlots.Num();
+		const int32 NewNum = FMath::Max(ObjectIndex + 1, GUObjectArray.GetObjectArrayNum());
+		ObjectSlots.SetNumUninitialized(NewNum);
+		ObjectPositions.SetNumUninitialized(NewNum);
+		for (int32 Index = OldNum; Index < NewNum; ++Index)
+		{
+			ObjectSlots[Index] = INDEX_NONE;
+		}
+	}
+	if (ObjectSlots[ObjectIndex] != INDEX_NONE)
+	{
+		return;
+	}
+
+	const UObjectBase* Object = GetIndexedObject(ObjectIndex);
+	if (Object == nullptr)
+	{
+		return;
+	}
+	const int32 Slot = FindOrAddNameSlot(Object->GetFName().GetComparisonIndex());
+	ObjectPositions[ObjectIndex] = SlotObjects[Slot].Add(ObjectIndex);
+	ObjectSlots[ObjectIndex] = Slot;
+}
+
+void FUBrowseNameIndex::UnindexObject(int32 ObjectIndex)
+{
+	if (!ObjectSlots.IsValidIndex(ObjectIndex) || (ObjectSlots[ObjectIndex] == INDEX_NONE))
+	{
+		return;
+	}
+
+	// swap the last object of the slot into the freed position
+	TArray<int32>& Objects = SlotObjects[ObjectSlots[ObjectIndex]];
+	const int32 Position = ObjectPositions[ObjectIndex];
+	const int32 LastObjectIndex = Objects.Last();
+	Objects[Position] = LastObjectIndex;
+	ObjectPositions[LastObjectIndex] = Position;
+	Objects.Pop(EAllowShrinking::No);
+	ObjectSlots[ObjectIndex] = INDEX_NONE;
+}
+
+void FUBrowseNameIndex::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+	// a new number or outer keeps the object under the same name slot
+	if (!bValid || (Object->GetFName().GetComparisonIndex() == OldName.GetComparisonIndex()))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&RenamedLock);
+	RenamedIndices.Add(GUObjectArray.ObjectToIndex(Object));
+}
+
+void FUBrowseNameIndex::FindCandidateSlots(const FString& FoldedText, TArray<int32>& OutSlots) const
+{
+	OutSlots.Reset();
+
+	TArray<uint64> Trigrams;
+	GetTrigrams(FoldedText, Trigrams);
+	if (Trigrams.Num() == 0)
+	{
+		// too short for a trigram, check every distinct name, still far fewer than objects
+		OutSlots.SetNumUninitialized(SlotNames.Num());
+		for (int32 Slot = 0; Slot < SlotNames.Num(); ++Slot)
+		{
+			OutSlots[Slot] = Slot;
+		}
+		return;
+	}
+
+	TArray<const TArray<int32>*> PostingLists;
+	for (uint64 Trigram : Trigrams)
+	{
+		const TArray<int32>* PostingList = TrigramSlots.Find(Trigram);
+		if (PostingList == nullptr)
+		{
+			return;
+		}
+		PostingLists.Add(PostingList);
+	}
+
+	// walk the rarest trigram's list, looking each slot up in the others
+	PostingLists.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+	for (int32 Slot : *PostingLists[0])
+	{
+		bool bInAll = true;
+		for (int32 ListIndex = 1; bInAll && ListIndex < PostingLists.Num(); ++ListIndex)
+		{
+			bInAll = Algo::BinarySearch(*PostingLists[ListIndex], Slot) != INDEX_NONE;
+		}
+		if (bInAll)
+		{
+			OutSlots.Add(Slot);
+		}
+	}
+}
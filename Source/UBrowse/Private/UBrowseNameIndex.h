@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UBrowseObjectTracker.h"
+
+/**
+ * Substring index over the names of live objects, answering the same question as
+ * GetName().Contains(Substring) without building a string per object.
+ *
+ * Each distinct base name (FName comparison index) gets a dense slot holding the objects named
+ * after it, and every case folded trigram of the name points at the slots containing it. Slots
+ * are only ever appended, so posting lists stay sorted and are intersected with binary searches.
+ * Kept current from object create/delete events like FUBrowseClassHistogram, and from renames, which
+ * move an object to the slot of its new name.
+ */
+class FUBrowseNameIndex
+{
+public:
+	FUBrowseNameIndex();
+	~FUBrowseNameIndex();
+
+	/** Index every live object from scratch */
+	void Rebuild();
+
+	/** Apply the objects created/deleted since the last update, rebuilding on first use or when the changes overflowed */
+	void Update();
+
+	bool IsValid() const { return bValid; }
+
+	/** @return true if the index can answer a substring query, a run of digits alone could be any object's number suffix */
+	static bool CanQuery(const FString& Substring);
+
+	/**
+	 * Find the objects whose name contains a substring, ignoring case like FString::Contains.
+	 * Objects renamed since the last update are dropped by the final check and found under their new name after it.
+	 *
+	 * @param Substring         Text to look for, CanQuery must be true for it
+	 * @param OutObjectIndices  Receives the GUObjectArray slots of the matching objects, in no particular order
+	 */
+	void Query(const FString& Substring, TArray<int32>& OutObjectIndices) const;
+
+	/** @return Number of distinct names indexed */
+	int32 GetNumNames() const { return SlotNames.Num(); }
+
+private:
+	static uint64 MakeTrigram(TCHAR A, TCHAR B, TCHAR C);
+	static void GetTrigrams(const FString& FoldedText, TArray<uint64>& OutTrigrams);
+
+	int32 FindOrAddNameSlot(FNameEntryId NameId);
+	void IndexObject(int32 ObjectIndex);
+	void UnindexObject(int32 ObjectIndex);
+
+	void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName);
+
+	/** Slots whose name contains every trigram of the folded text, every slot if it is too short to have any */
+	void FindCandidateSlots(const FString& FoldedText, TArray<int32>& OutSlots) const;
+
+	/* Comparison index of a name to its dense slot */
+	TMap<FNameEntryId, int32> NameSlots;
+
+	/* Case folded name of each slot, without number */
+	TArray<FString> SlotNames;
+
+	/* Comparison index of each slot's name */
+	TArray<FNameEntryId> SlotNameIds;
+
+	/* GUObjectArray slots of the objects using each name */
+	TArray<TArray<int32>> SlotObjects;
+
+	/* Trigram to the ascending slots whose name contains it */
+	TMap<uint64, TArray<int32>> TrigramSlots;
+
+	/* Per GUObjectArray index, the name slot the object was indexed under and its position in SlotObjects */
+	TArray<int32> ObjectSlots;
+	TArray<int32> ObjectPositions;
+
+	FUBrowseObjectTracker Tracker;
+
+	/* Slots of the objects given a new base name since the last update, renames can happen on any thread */
+	FCriticalSection RenamedLock;
+	TArray<int32> RenamedIndices;
+
+	bool bValid = false;
+};
@@ -1,97 +1,56 @@
 
 #include "UBrowseNode.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/Level.h"
 #include "UBrowseGraph.h"
+#include "UBrowseObjectFlags.h"
 #include "UObject/ObjectMacros.h"
 
-// TO DO : Mebby use LexToString
 namespace {
-	FString GetFlagsAsText(EObjectFlags Param)
+	// this is needed to work around an engine bug where default bp classes do not have a valid description
+	FString GetDescription(UObject* Obj)
 	{
-		FString Result;
-		if (Param == 0) {
-			Result = TEXT("No Flags");
-			return Result;
-		}
-		if (Param & RF_Public) {
-			Result.Append(TEXT("|Public"));
-		}
-		if (Param & RF_Standalone) {
-			Result.Append(TEXT("|Standalone"));
-		}
-		if (Param & RF_MarkAsNative) {
-			Result.Append(TEXT("|Marked As Native"));
-		}
-		if (Param & RF_Transactional) {
-			Result.Append(TEXT("|Transatctional"));
-		}
-		if (Param & RF_ClassDefaultObject) {
-			Result.Append(TEXT("|CDO"));
-		}
-		if (Param & RF_ArchetypeObject) {
-			Result.Append(TEXT("|Archetype"));
-		}
-		if (Param & RF_Transient) {
-			Result.Append(TEXT("|Transient"));
-		}
-		if (Param & RF_MarkAsRootSet) {
-			Result.Append(TEXT("|Marked as Root"));
-		}
-		if (Param & RF_TagGarbageTemp) {
-			Result.Append(TEXT("|Tageed Garbage"));
-		}
-		if (Param & RF_NeedInitialization) {
-			Result.Append(TEXT("|Needs Initialization"));
-		}
-		if (Param & RF_NeedLoad) {
-			Result.Append(TEXT("|Needs Loading"));
-		}
-		if (Param & RF_NeedPostLoad) {
-			Result.Append(TEXT("|Needs Post Loading"));
-		}
-		if (Param & RF_NeedPostLoadSubobjects) {
-			Result.Append(TEXT("|Subobjects need Post Loading"));
-		}
-		if (Param & RF_NewerVersionExists) {
-			Result.Append(TEXT("|Subobjects need Post Loading"));
-		}
-		if (Param & RF_BeginDestroyed) {
-			Result.Append(TEXT("|Being destroyed"));
-		}
-		if (Param & RF_FinishDestroyed) {
-			Result.Append(TEXT("|Is destroyed"));
-		}
-		if (Param & RF_BeingRegenerated) {
-			Result.Append(TEXT("|Being Regenerated"));
-		}
-		if (Param & RF_DefaultSubObject) {
-			Result.Append(TEXT("|Default Subobject"));
-		}
-		if (Param & RF_WasLoaded) {
-			Result.Append(TEXT("|Was Loaded"));
+		UBlueprint* BPObj = Cast<UBlueprint>(Obj);
+		if ((BPObj != nullptr) && (BPObj->ParentClass == nullptr))
+		{
+			return FString(TEXT("Default BP"));
 		}
-		if (Param & RF_TextExportTransient) {
-			Result.Append(TEXT("|Do not export as text"));
+		return Obj->GetDesc();
+	}
+
+	EUBrowseNodeColor GetNodeColor(const UObject* Obj)
+	{
+		if (Obj == nullptr)
+		{
+			return EUBrowseNodeColor::Missing;
 		}
-		if (Param & RF_LoadCompleted) {
-			Result.Append(TEXT("|Load Complete"));
+		if (Obj->IsA(UClass::StaticClass()))
+		{
+			return EUBrowseNodeColor::Class;
 		}
-		if (Param & RF_InheritableComponentTemplate) {
-			Result.Append(TEXT("|Inheritable Template"));
+		const UClass* Class = Obj->GetClass();
+		if (Class->IsChildOf(UBlueprint::StaticClass()))
+		{
+			return EUBrowseNodeColor::Blueprint;
 		}
-		if (Param &	RF_StrongRefOnFrame) {
-			Result.Append(TEXT("|Strong Ref on Function Frame"));
+		if (Class->IsChildOf(UBlueprintGeneratedClass::StaticClass()))
+		{
+			return EUBrowseNodeColor::BlueprintGeneratedClass;
 		}
-		if (Param &	RF_NonPIEDuplicateTransient) {
-			Result.Append(TEXT("|Non PIE Duplicate Transient"));
+		if (Class->IsChildOf(UPackage::StaticClass()))
+		{
+			return EUBrowseNodeColor::Package;
 		}
-		if (Param & RF_WillBeLoaded) {
-			Result.Append(TEXT("|Will Be Loaded"));
+		if (Class->IsChildOf(ULevel::StaticClass()))
+		{
+			return EUBrowseNodeColor::Level;
 		}
-		if (Param & RF_HasExternalPackage) {
-			Result.Append(TEXT("|Has External Package"));
+		if (Class->IsChildOf(AActor::StaticClass()))
+		{
+			return EUBrowseNodeColor::Actor;
 		}
-		Result.Append("|");
-		return Result;
+		return EUBrowseNodeColor::Object;
 	}
 }
 
@@ -101,7 +60,6 @@ UBrowseNode::UBrowseNode(const FObjectInitializer& ObjectInitializer)
 	ChildrenPin = nullptr;
 	ParentPin = nullptr;
 	NodeObject = nullptr;
-	bIsFixedInPlace = false;
 }
 
 void UBrowseNode::AddChild(UBrowseNode* ChildNode)
@@ -132,6 +90,10 @@ void UBrowseNode::AllocateDefaultPins()
 		GeneratedByPin = CreatePin(EEdGraphPinDirection::EGPD_Output, FName(TEXT("UBrowse")),  FName(TEXT("Generated By")), DefaultPinParams);
 		GeneratesPin = CreatePin(EEdGraphPinDirection::EGPD_Input, FName(TEXT("UBrowse")),  FName(TEXT("Generates")), DefaultPinParams);		
 	}
+	ReferencersPin = CreatePin(EEdGraphPinDirection::EGPD_Input, FName(TEXT("UBrowse")), FName(TEXT("Referenced By")), DefaultPinParams);
+	ReferencesPin = CreatePin(EEdGraphPinDirection::EGPD_Output, FName(TEXT("UBrowse")), FName(TEXT("References")), DefaultPinParams);
+	ReferencersPin->bHidden = true;
+	ReferencesPin->bHidden = true;
 	CDOPin->bHidden = (NodeClass == nullptr);
 	GeneratedByPin->bHidden = !NodeClass->IsChildOf(UBlueprintGeneratedClass::StaticClass());
 	if (NodeClass != nullptr)
@@ -150,38 +112,10 @@ void UBrowseNode::AllocateDefaultPins()
 
 void UBrowseNode::SetupNode(const FIntPoint& NodePosition, UObject* NodeUObject)
 {
-
-	// this is needed to work around an engine bug where default bp classes do not have a valid description
-	auto GetDescription = [](UObject *Obj)
-	{
-		UBlueprint* BPObj = Cast<UBlueprint>(Obj);
-		if (BPObj == nullptr)
-		{
-			return Obj->GetDesc();
-		}		
-		if (BPObj->ParentClass == nullptr)
-		{
-			return FString(TEXT("Default BP"));
-		}
-		return Obj->GetDesc();
-	};
-
 	NodeObject = NodeUObject;
 	if (NodeObject.IsValid())
 	{
-		FString Title;
-		Title.Empty(256);
-		NodeClass = NodeObject->GetClass();
-		if (NodeClass != nullptr)	
-		{
-			NodeClass->AppendName(Title);
-			Title += " -> ";
-		}
-		NodeUObject->AppendName(Title);
-		NodeTitle = FText::FromString(Title);
-		ShortDesc = GetDescription(NodeUObject);
-		EObjectFlags UObjectFlags = NodeUObject->GetFlags();
-		LongDesc = GetFlagsAsText(UObjectFlags);
+		UpdateVisuals();
 		NodePosX = NodePosition.X;
 		NodePosY = NodePosition.Y;
 
@@ -189,14 +123,112 @@ void UBrowseNode::SetupNode(const FIntPoint& NodePosition, UObject* NodeUObject)
 	}
 }
 
-FText UBrowseNode::GetTooltipText() const
+void UBrowseNode::UpdateVisuals()
 {
-	FText Result;
-	if ((NodeObject.IsValid()) && (NodeClass != nullptr))
+	UObject* NodeUObject = NodeObject.Get();
+	NodeClass = NodeUObject != nullptr ? NodeUObject->GetClass() : nullptr;
+	Color = GetNodeColor(NodeUObject);
+	// the class tooltip comes out of metadata, far too slow to look up on every hover
+	Tooltip = NodeClass != nullptr ? NodeClass->GetToolTipText() : FText::GetEmpty();
+	if (NodeUObject == nullptr)
 	{
-		Result = NodeClass->GetToolTipText();
+		return;
 	}
-	return Result;
+
+	if (bIsSummary)
+	{
+		ShortDesc = FText::FromString(FString::Printf(TEXT("Inners of %s"), *GetNameSafe(SummaryOuter.Get())));
+		SetNumExpanded(NumExpanded);
+		return;
+	}
+
+	FString Title;
+	Title.Empty(256);
+	NodeClass->AppendName(Title);
+	Title += " -> ";
+	NodeUObject->AppendName(Title);
+	NodeTitle = FText::FromString(Title);
+	ShortDesc = FText::FromString(GetDescription(NodeUObject));
+	LongDesc = FUBrowseObjectFlags::GetText(NodeUObject);
+}
+
+bool UBrowseNode::ReplaceObject(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	// the old objects are already garbage by the time they are replaced
+	bool bReplaced = false;
+	if (UObject* const* Replacement = ReplacementMap.Find(NodeObject.Get(true)))
+	{
+		NodeObject = *Replacement;
+		bReplaced = true;
+	}
+	if (UObject* const* Replacement = bIsSummary ? ReplacementMap.Find(SummaryOuter.Get(true)) : nullptr)
+	{
+		SummaryOuter = *Replacement;
+		bReplaced = true;
+	}
+	if (bReplaced)
+	{
+		UpdateVisuals();
+	}
+	return bReplaced;
+}
+
+void UBrowseNode::ResetForReuse()
+{
+	for (UEdGraphPin* Pin : TArray<UEdGraphPin*>(Pins))
+	{
+		RemovePin(Pin);
+	}
+	ChildrenPin = nullptr;
+	ParentPin = nullptr;
+	CDOPin = nullptr;
+	OwnerPin = nullptr;
+	GeneratesPin = nullptr;
+	GeneratedByPin = nullptr;
+	ReferencersPin = nullptr;
+	ReferencesPin = nullptr;
+
+	NodeObject = nullptr;
+	NodeClass = nullptr;
+	NodeTitle = FText::GetEmpty();
+	ShortDesc = FText::GetEmpty();
+	LongDesc = FText::GetEmpty();
+	Tooltip = FText::GetEmpty();
+	Color = EUBrowseNodeColor::Missing;
+	NodePosX = 0;
+	NodePosY = 0;
+	bIsSummary = false;
+	SummaryOuter = nullptr;
+	NumSummarized = 0;
+	NumExpanded = 0;
+}
+
+void UBrowseNode::SetupSummaryNode(const FIntPoint& NodePosition, UObject* Outer, UClass* InnerClass, int32 NumInners)
+{
+	// the class stands in for the objects, so the node is coloured and documented like them
+	SetupNode(NodePosition, InnerClass);
+	bIsSummary = true;
+	SummaryOuter = Outer;
+	NumSummarized = NumInners;
+	NumExpanded = 0;
+	UpdateVisuals();
+
+	for (UEdGraphPin* Pin : Pins)
+	{
+		Pin->bHidden = (Pin != ChildrenPin) && (Pin != ParentPin);
+	}
+}
+
+void UBrowseNode::SetNumExpanded(int32 InNumExpanded)
+{
+	NumExpanded = InNumExpanded;
+	NodeTitle = FText::FromString(FString::Printf(TEXT("%d x %s"), NumSummarized, *GetNameSafe(NodeObject.Get())));
+	LongDesc = FText::FromString(NumExpanded < NumSummarized ? FString::Printf(TEXT("%d of %d shown, double click for more"), NumExpanded, NumSummarized) : FString::Printf(TEXT("All %d shown"), NumSummarized));
+}
+
+FText UBrowseNode::GetTooltipText() const
+{
+	return Tooltip;
 }
 
 FText UBrowseNode::GetNodeTitle(ENodeTitleType::Type TitleType) const
@@ -234,3 +266,21 @@ UEdGraphPin* UBrowseNode::GetGeneratesPin()
 	return GeneratesPin;
 }
 
+UEdGraphPin* UBrowseNode::GetReferencersPin()
+{
+	return ReferencersPin;
+}
+
+UEdGraphPin* UBrowseNode::GetReferencesPin()
+{
+	return ReferencesPin;
+}
+
+void UBrowseNode::ShowReferencePins()
+{
+	for (UEdGraphPin* Pin : Pins)
+	{
+		Pin->bHidden = (Pin != ReferencersPin) && (Pin != ReferencesPin);
+	}
+}
+
@@ -5,6 +5,19 @@
 #include "EditorClassUtils.h"
 #include "UBrowseNode.generated.h"
 
+/* Which graph editor color a node's title takes, decided once from the class of its object */
+enum class EUBrowseNodeColor : uint8
+{
+	Missing,
+	Class,
+	Blueprint,
+	BlueprintGeneratedClass,
+	Package,
+	Level,
+	Actor,
+	Object
+};
+
 UCLASS()
 class UBrowseNode : public UEdGraphNode
 {
@@ -12,29 +25,54 @@ class UBrowseNode : public UEdGraphNode
 public:
 	void AddChild(UBrowseNode* ChildNode);
 	void SetupNode(const FIntPoint& NodePosition, UObject* object);
+
+	/* Drop pins and state so the node can be set up again for another object */
+	void ResetForReuse();
+
+	/* Stand in for the inners of Outer of one class, nodes for the inners themselves are only made a page at a time */
+	void SetupSummaryNode(const FIntPoint& NodePosition, UObject* Outer, UClass* InnerClass, int32 NumInners);
+	bool IsSummary() const { return bIsSummary; }
+	UObject* GetSummaryOuter() const { return SummaryOuter.Get(); }
+	UClass* GetSummaryClass() const { return bIsSummary ? Cast<UClass>(NodeObject.Get()) : nullptr; }
+	int32 GetNumSummarized() const { return NumSummarized; }
+	/* Inners of a summary node given nodes of their own so far */
+	int32 GetNumExpanded() const { return NumExpanded; }
+	void SetNumExpanded(int32 InNumExpanded);
 	virtual UEdGraphPin* GetChildrenPin();
 	virtual UEdGraphPin* GetParentPin();
 	virtual UEdGraphPin* GetCDOPin();
 	virtual UEdGraphPin* GetOwnerPin();
 	virtual UEdGraphPin* GetGeneratedByPin();
 	virtual UEdGraphPin* GetGeneratesPin();
+	virtual UEdGraphPin* GetReferencersPin();
+	virtual UEdGraphPin* GetReferencesPin();
 
-	const FText GetShortDesc() const { return FText::FromString(ShortDesc);  }
-	const FText GetLongDesc() const { return FText::FromString(LongDesc);  }
+	/* Hide the outer/CDO/owner/blueprint pins and show the reference pins instead, for the reference graph */
+	void ShowReferencePins();
+
+	const FText& GetShortDesc() const { return ShortDesc; }
+	const FText& GetLongDesc() const { return LongDesc; }
 	const UObject* GetUObject() const { return NodeObject.IsValid() ? NodeObject.Get() : nullptr; }
+	EUBrowseNodeColor GetColor() const { return Color; }
 	FText GetTooltipText() const override;
 
-	bool IsFixedInPlace() const { return bIsFixedInPlace; }
-	void FixInPlace() { bIsFixedInPlace = true; }
+	/* Point the node at the new object if its own was reinstanced, returns whether it was */
+	bool ReplaceObject(const TMap<UObject*, UObject*>& ReplacementMap);
+
 	// UEdGraphNode implementation
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 	virtual void AllocateDefaultPins() override;
 	// End UEdGraphNode implementation
 
 private:
+	/* Work out the title, descriptions, tooltip and color from the object, only on setup and reinstancing */
+	void UpdateVisuals();
+
 	FText NodeTitle;
-	FString ShortDesc;
-	FString LongDesc;
+	FText ShortDesc;
+	FText LongDesc;
+	FText Tooltip;
+	EUBrowseNodeColor Color = EUBrowseNodeColor::Missing;
 	TWeakObjectPtr<UObject> NodeObject;
 	UEdGraphPin* ChildrenPin = nullptr;
 	UEdGraphPin* ParentPin = nullptr;
@@ -42,6 +80,11 @@ private:
 	UEdGraphPin* OwnerPin = nullptr;
 	UEdGraphPin* GeneratesPin = nullptr;
 	UEdGraphPin* GeneratedByPin = nullptr;
+	UEdGraphPin* ReferencersPin = nullptr;
+	UEdGraphPin* ReferencesPin = nullptr;
 	const UClass*  NodeClass = nullptr;
-	bool bIsFixedInPlace;
+	bool bIsSummary = false;
+	TWeakObjectPtr<UObject> SummaryOuter;
+	int32 NumSummarized = 0;
+	int32 NumExpanded = 0;
 };
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "UBrowseObjectFilter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectArray.h"
+
+bool FUBrowseObjectFilter::SetQueryText(const FString& Text, FText& OutError)
+{
+	TSharedPtr<const FUBrowseQuery> NewQuery = FUBrowseQuery::Compile(Text, OutError);
+	if (!NewQuery.IsValid())
+	{
+		return false;
+	}
+	FilterString = Text;
+	Query = Text.IsEmpty() ? nullptr : NewQuery;
+	return true;
+}
+
+const UClass* FUBrowseObjectFilter::GetIndexClass() const
+{
+	const UClass* QueryClass = Query.IsValid() ? Query->GetIndexClass() : nullptr;
+	if ((QueryClass != nullptr) && ((FilterClass == nullptr) || QueryClass->IsChildOf(FilterClass)))
+	{
+		return QueryClass;
+	}
+	return FilterClass;
+}
+
+const FString& FUBrowseObjectFilter::GetIndexSubstring() const
+{
+	static const FString NoSubstring;
+	return Query.IsValid() ? Query->GetIndexSubstring() : NoSubstring;
+}
+
+EObjectFlags FUBrowseObjectFilter::GetExclusionFlags() const
+{
+	EObjectFlags ExclusionFlags{ RF_NoFlags };
+
+	if (!bShouldIncludeDefaultSubObjects)
+	{
+		ExclusionFlags |= RF_DefaultSubObject;
+	}
+
+	if (!bShouldIncludeArchetypeObjects)
+	{
+		ExclusionFlags |= RF_ArchetypeObject;
+	}
+
+	if (!bShouldIncludeClassDefaultObjects)
+	{
+		ExclusionFlags |= RF_ClassDefaultObject;
+	}
+
+	return ExclusionFlags;
+}
+
+bool FUBrowseObjectFilter::Matches(const UObject* Object) const
+{
+	if (Object->HasAnyFlags(GetExclusionFlags()))
+	{
+		return false;
+	}
+
+	if (bOnlyListGCObjects && GUObjectArray.IsDisregardForGC(Object))
+	{
+		return false;
+	}
+
+	if (bOnlyListRootObjects && !Object->IsRooted())
+	{
+		return false;
+	}
+
+	if (!bIncludeTransient)
+	{
+		UPackage* ContainerPackage = Object->GetOutermost();
+		if (ContainerPackage == GetTransientPackage() || ContainerPackage->HasAnyFlags(RF_Transient))
+		{
+			return false;
+		}
+	}
+
+	if ((FilterOuter != nullptr) && (Object->GetOuter() != FilterOuter))
+	{
+		return false;
+	}
+
+	if ((FilterPackage != nullptr) && (Object->GetPackage() != FilterPackage))
+	{
+		return false;
+	}
+
+	if ((FilterClass != nullptr) && (!Object->GetClass()->IsChildOf(FilterClass)))
+	{
+		return false;
+	}
+
+	if (Query.IsValid() && !Query->Matches(Object))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool FUBrowseObjectFilter::operator==(const FUBrowseObjectFilter& Other) const
+{
+	return bShouldIncludeClassDefaultObjects == Other.bShouldIncludeClassDefaultObjects
+		&& bShouldIncludeDefaultSubObjects == Other.bShouldIncludeDefaultSubObjects
+		&& bShouldIncludeArchetypeObjects == Other.bShouldIncludeArchetypeObjects
+		&& bOnlyListRootObjects == Other.bOnlyListRootObjects
+		&& bOnlyListGCObjects == Other.bOnlyListGCObjects
+		&& bIncludeTransient == Other.bIncludeTransient
+		&& FilterClass == Other.FilterClass
+		&& FilterOuter == Other.FilterOuter
+		&& FilterPackage == Other.FilterPackage
+		&& FilterString.Equals(Other.FilterString, ESearchCase::CaseSensitive);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UBrowseQuery.h"
+#include "UObject/Object.h"
+
+/**
+ * The options the live object list is filtered with.
+ * Held by value so the browser can tell when a filter changed and a full rescan is needed.
+ */
+struct FUBrowseObjectFilter
+{
+	bool bShouldIncludeClassDefaultObjects = true;
+	bool bShouldIncludeDefaultSubObjects = true;
+	bool bShouldIncludeArchetypeObjects = true;
+	bool bOnlyListRootObjects = false;
+	bool bOnlyListGCObjects = false;
+	bool bIncludeTransient = false;
+	UClass* FilterClass = nullptr;
+
+	/* Text of Query, what filters are compared by */
+	FString FilterString;
+
+	/* Compiled from FilterString, null when it is empty */
+	TSharedPtr<const FUBrowseQuery> Query;
+
+	/* Only objects directly inside this outer */
+	UObject* FilterOuter = nullptr;
+
+	/* Only objects saved in this package */
+	UPackage* FilterPackage = nullptr;
+
+	/**
+	 * Compile a query and use it as the name/query part of this filter.
+	 *
+	 * @return false, leaving the filter unchanged, if the text does not parse
+	 */
+	bool SetQueryText(const FString& Text, FText& OutError);
+
+	/** @return The narrowest class every match must be, for a class index lookup */
+	const UClass* GetIndexClass() const;
+
+	/** @return A substring every match's name contains, for a name index lookup, or empty */
+	const FString& GetIndexSubstring() const;
+
+	/** @return The object flags that exclude an object from the results */
+	EObjectFlags GetExclusionFlags() const;
+
+	/** @return true if the object passes every option of this filter */
+	bool Matches(const UObject* Object) const;
+
+	bool operator==(const FUBrowseObjectFilter& Other) const;
+
+	bool operator!=(const FUBrowseObjectFilter& Other) const
+	{
+		return !(*this == Other);
+	}
+};
@@ -0,0 +1,159 @@
+#include "UBrowseObjectFlags.h"
+#include "UObject/Object.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace
+{
+	constexpr FUBrowseFlagDescriptor FlagDescriptors[] =
+	{
+		{ TEXT("Public"), nullptr, RF_Public, EInternalObjectFlags::None },
+		{ TEXT("Standalone"), nullptr, RF_Standalone, EInternalObjectFlags::None },
+		{ TEXT("MarkAsNative"), nullptr, RF_MarkAsNative, EInternalObjectFlags::None },
+		{ TEXT("Transactional"), nullptr, RF_Transactional, EInternalObjectFlags::None },
+		{ TEXT("ClassDefaultObject"), TEXT("CDO"), RF_ClassDefaultObject, EInternalObjectFlags::None },
+		{ TEXT("ArchetypeObject"), TEXT("Archetype"), RF_ArchetypeObject, EInternalObjectFlags::None },
+		{ TEXT("Transient"), nullptr, RF_Transient, EInternalObjectFlags::None },
+		{ TEXT("MarkAsRootSet"), nullptr, RF_MarkAsRootSet, EInternalObjectFlags::None },
+		{ TEXT("TagGarbageTemp"), nullptr, RF_TagGarbageTemp, EInternalObjectFlags::None },
+		{ TEXT("NeedInitialization"), nullptr, RF_NeedInitialization, EInternalObjectFlags::None },
+		{ TEXT("NeedLoad"), nullptr, RF_NeedLoad, EInternalObjectFlags::None },
+		{ TEXT("KeepForCooker"), nullptr, RF_KeepForCooker, EInternalObjectFlags::None },
+		{ TEXT("NeedPostLoad"), nullptr, RF_NeedPostLoad, EInternalObjectFlags::None },
+		{ TEXT("NeedPostLoadSubobjects"), nullptr, RF_NeedPostLoadSubobjects, EInternalObjectFlags::None },
+		{ TEXT("NewerVersionExists"), nullptr, RF_NewerVersionExists, EInternalObjectFlags::None },
+		{ TEXT("BeginDestroyed"), nullptr, RF_BeginDestroyed, EInternalObjectFlags::None },
+		{ TEXT("FinishDestroyed"), nullptr, RF_FinishDestroyed, EInternalObjectFlags::None },
+		{ TEXT("BeingRegenerated"), nullptr, RF_BeingRegenerated, EInternalObjectFlags::None },
+		{ TEXT("DefaultSubObject"), TEXT("DSO"), RF_DefaultSubObject, EInternalObjectFlags::None },
+		{ TEXT("WasLoaded"), nullptr, RF_WasLoaded, EInternalObjectFlags::None },
+		{ TEXT("TextExportTransient"), nullptr, RF_TextExportTransient, EInternalObjectFlags::None },
+		{ TEXT("LoadCompleted"), nullptr, RF_LoadCompleted, EInternalObjectFlags::None },
+		{ TEXT("InheritableComponentTemplate"), nullptr, RF_InheritableComponentTemplate, EInternalObjectFlags::None },
+		{ TEXT("DuplicateTransient"), nullptr, RF_DuplicateTransient, EInternalObjectFlags::None },
+		{ TEXT("StrongRefOnFrame"), nullptr, RF_StrongRefOnFrame, EInternalObjectFlags::None },
+		{ TEXT("NonPIEDuplicateTransient"), nullptr, RF_NonPIEDuplicateTransient, EInternalObjectFlags::None },
+		{ TEXT("WillBeLoaded"), nullptr, RF_WillBeLoaded, EInternalObjectFlags::None },
+		{ TEXT("HasExternalPackage"), nullptr, RF_HasExternalPackage, EInternalObjectFlags::None },
+#if (ENGINE_MAJOR_VERSION > 5) || ((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 4))
+		{ TEXT("HasPlaceholderType"), nullptr, RF_HasPlaceholderType, EInternalObjectFlags::None },
+#endif
+		{ TEXT("MirroredGarbage"), nullptr, RF_MirroredGarbage, EInternalObjectFlags::None },
+		{ TEXT("AllocatedInSharedPage"), nullptr, RF_AllocatedInSharedPage, EInternalObjectFlags::None },
+		{ TEXT("LoaderImport"), nullptr, RF_NoFlags, EInternalObjectFlags::LoaderImport },
+		{ TEXT("Garbage"), nullptr, RF_NoFlags, EInternalObjectFlags::Garbage },
+#if (ENGINE_MAJOR_VERSION > 5) || ((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 4))
+		{ TEXT("AsyncLoadingPhase1"), nullptr, RF_NoFlags, EInternalObjectFlags::AsyncLoadingPhase1 },
+#endif
+		{ TEXT("ReachableInCluster"), nullptr, RF_NoFlags, EInternalObjectFlags::ReachableInCluster },
+		{ TEXT("ClusterRoot"), nullptr, RF_NoFlags, EInternalObjectFlags::ClusterRoot },
+		{ TEXT("Native"), nullptr, RF_NoFlags, EInternalObjectFlags::Native },
+		{ TEXT("Async"), nullptr, RF_NoFlags, EInternalObjectFlags::Async },
+#if (ENGINE_MAJOR_VERSION > 5) || ((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 4))
+		{ TEXT("AsyncLoadingPhase2"), nullptr, RF_NoFlags, EInternalObjectFlags::AsyncLoadingPhase2 },
+#else
+		{ TEXT("AsyncLoading"), nullptr, RF_NoFlags, EInternalObjectFlags::AsyncLoading },
+#endif
+		{ TEXT("Unreachable"), nullptr, RF_NoFlags, EInternalObjectFlags::Unreachable },
+#if (ENGINE_MAJOR_VERSION > 5) || ((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 3))
+		{ TEXT("RefCounted"), nullptr, RF_NoFlags, EInternalObjectFlags::RefCounted },
+#endif
+		{ TEXT("RootSet"), TEXT("Root"), RF_NoFlags, EInternalObjectFlags::RootSet },
+		{ TEXT("PendingConstruction"), nullptr, RF_NoFlags, EInternalObjectFlags::PendingConstruction },
+	};
+
+	/* Longest list the table can produce fits without growing */
+	constexpr int32 FlagTextReserve = 768;
+
+	/* Bits the table has names for, the rest, such as the reachability bits garbage collection flips, never show up in text.
+	   Combined with plain | since the compound flag operators are not constexpr on every engine version */
+	constexpr EObjectFlags KnownFlags = []()
+	{
+		EObjectFlags Flags = RF_NoFlags;
+		for (const FUBrowseFlagDescriptor& Descriptor : FlagDescriptors)
+		{
+			Flags = Flags | Descriptor.Flags;
+		}
+		return Flags;
+	}();
+
+	constexpr EInternalObjectFlags KnownInternalFlags = []()
+	{
+		EInternalObjectFlags InternalFlags = EInternalObjectFlags::None;
+		for (const FUBrowseFlagDescriptor& Descriptor : FlagDescriptors)
+		{
+			InternalFlags = InternalFlags | Descriptor.InternalFlags;
+		}
+		return InternalFlags;
+	}();
+}
+
+TConstArrayView<FUBrowseFlagDescriptor> FUBrowseObjectFlags::GetDescriptors()
+{
+	return FlagDescriptors;
+}
+
+const FUBrowseFlagDescriptor* FUBrowseObjectFlags::Find(FStringView Name)
+{
+	for (const FUBrowseFlagDescriptor& Descriptor : FlagDescriptors)
+	{
+		if (Name.Equals(Descriptor.Name, ESearchCase::IgnoreCase) || ((Descriptor.Alias != nullptr) && Name.Equals(Descriptor.Alias, ESearchCase::IgnoreCase)))
+		{
+			return &Descriptor;
+		}
+	}
+	return nullptr;
+}
+
+void FUBrowseObjectFlags::Append(EObjectFlags Flags, EInternalObjectFlags InternalFlags, FStringBuilderBase& Out)
+{
+	const int32 StartLen = Out.Len();
+	for (const FUBrowseFlagDescriptor& Descriptor : FlagDescriptors)
+	{
+		if (((Flags & Descriptor.Flags) != 0) || EnumHasAnyFlags(InternalFlags, Descriptor.InternalFlags))
+		{
+			if (Out.Len() > StartLen)
+			{
+				Out << TEXT('|');
+			}
+			Out << Descriptor.Name;
+		}
+	}
+	if (Out.Len() == StartLen)
+	{
+		Out << TEXT("None");
+	}
+}
+
+FString FUBrowseObjectFlags::ToString(EObjectFlags Flags, EInternalObjectFlags InternalFlags)
+{
+	TStringBuilder<FlagTextReserve> Builder;
+	Append(Flags, InternalFlags, Builder);
+	return FString(Builder.ToView());
+}
+
+FString FUBrowseObjectFlags::ToString(const UObject* Object)
+{
+	return Object != nullptr ? ToString(Object->GetFlags(), Object->GetInternalFlags()) : FString(TEXT("None"));
+}
+
+FText FUBrowseObjectFlags::GetText(EObjectFlags Flags, EInternalObjectFlags InternalFlags)
+{
+	check(IsInGameThread());
+
+	// only named bits go into the key, so masks that print the same share one entry
+	Flags &= KnownFlags;
+	InternalFlags &= KnownInternalFlags;
+
+	static TMap<uint64, FText> TextByMask;
+	const uint64 Mask = (uint64(uint32(Flags)) << 32) | uint64(uint32(InternalFlags));
+	if (const FText* Text = TextByMask.Find(Mask))
+	{
+		return *Text;
+	}
+	return TextByMask.Add(Mask, FText::FromString(ToString(Flags, InternalFlags)));
+}
+
+FText FUBrowseObjectFlags::GetText(const UObject* Object)
+{
+	return Object != nullptr ? GetText(Object->GetFlags(), Object->GetInternalFlags()) : GetText(RF_NoFlags);
+}
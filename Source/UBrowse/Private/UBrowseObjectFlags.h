@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+#include "UObject/ObjectMacros.h"
+
+/* One object flag or internal object flag and the names it goes by */
+struct FUBrowseFlagDescriptor
+{
+	/* Shown wherever flags are listed and matched by queries */
+	const TCHAR* Name;
+	/* Shorter name queries also accept, null if none */
+	const TCHAR* Alias;
+	EObjectFlags Flags;
+	EInternalObjectFlags InternalFlags;
+};
+
+/**
+ * Decodes EObjectFlags and EInternalObjectFlags masks from one table, shared by the graph nodes, the
+ * details panel, the Flags column of the object list and the query parser.
+ */
+class FUBrowseObjectFlags
+{
+public:
+	/** Every flag decoded, object flags first, each in bit order */
+	static TConstArrayView<FUBrowseFlagDescriptor> GetDescriptors();
+
+	/** The flag with this name or alias, ignoring case, null if there is none */
+	static const FUBrowseFlagDescriptor* Find(FStringView Name);
+
+	/** Append the names of the set flags separated by '|', or None */
+	static void Append(EObjectFlags Flags, EInternalObjectFlags InternalFlags, FStringBuilderBase& Out);
+
+	static FString ToString(EObjectFlags Flags, EInternalObjectFlags InternalFlags = EInternalObjectFlags::None);
+
+	/** Names of the flags of an object including its internal ones, None for null */
+	static FString ToString(const UObject* Object);
+
+	/**
+	 * The names of the set flags as text. Each distinct mask is formatted once and the text shared after that,
+	 * objects mostly come in a few dozen combinations. Game thread only
+	 */
+	static FText GetText(EObjectFlags Flags, EInternalObjectFlags InternalFlags = EInternalObjectFlags::None);
+
+	static FText GetText(const UObject* Object);
+};
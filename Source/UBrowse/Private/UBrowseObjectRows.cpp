@@ -0,0 +1,96 @@
+#include "UBrowseObjectRows.h"
+#include "UObject/Class.h"
+#include "UObject/Object.h"
+
+namespace
+{
+	template <typename ElementType>
+	void PermuteArray(TArray<ElementType>& Elements, TArrayView<const int32> Order)
+	{
+		TArray<ElementType> Permuted;
+		Permuted.SetNumUninitialized(Order.Num());
+		for (int32 Row = 0; Row < Order.Num(); ++Row)
+		{
+			Permuted[Row] = Elements[Order[Row]];
+		}
+		Elements = MoveTemp(Permuted);
+	}
+}
+
+void FUBrowseObjectRows::Reset()
+{
+	Handles.Reset();
+	NameIds.Reset();
+	NameNumbers.Reset();
+	ClassNameIds.Reset();
+	UniqueIds.Reset();
+}
+
+void FUBrowseObjectRows::Reserve(int32 NumRows)
+{
+	Handles.Reserve(NumRows);
+	NameIds.Reserve(NumRows);
+	NameNumbers.Reserve(NumRows);
+	ClassNameIds.Reserve(NumRows);
+	UniqueIds.Reserve(NumRows);
+}
+
+void FUBrowseObjectRows::Add(UObject* Object)
+{
+	const FName ObjectName = Object->GetFName();
+	Handles.Add(Object);
+	NameIds.Add(ObjectName.GetComparisonIndex());
+	NameNumbers.Add(ObjectName.GetNumber());
+	ClassNameIds.Add(Object->GetClass()->GetFName().GetComparisonIndex());
+	UniqueIds.Add(Object->GetUniqueID());
+}
+
+void FUBrowseObjectRows::Append(const FUBrowseObjectRows& Other, int32 FirstRow)
+{
+	const int32 NumRows = Other.Num() - FirstRow;
+	Handles.Append(Other.Handles.GetData() + FirstRow, NumRows);
+	NameIds.Append(Other.NameIds.GetData() + FirstRow, NumRows);
+	NameNumbers.Append(Other.NameNumbers.GetData() + FirstRow, NumRows);
+	ClassNameIds.Append(Other.ClassNameIds.GetData() + FirstRow, NumRows);
+	UniqueIds.Append(Other.UniqueIds.GetData() + FirstRow, NumRows);
+}
+
+int32 FUBrowseObjectRows::RemoveStale()
+{
+	// compact every array in one pass
+	int32 NumKept = 0;
+	for (int32 Row = 0; Row < Handles.Num(); ++Row)
+	{
+		if (!Handles[Row].IsValid(true))
+		{
+			continue;
+		}
+		if (NumKept != Row)
+		{
+			Handles[NumKept] = Handles[Row];
+			NameIds[NumKept] = NameIds[Row];
+			NameNumbers[NumKept] = NameNumbers[Row];
+			ClassNameIds[NumKept] = ClassNameIds[Row];
+			UniqueIds[NumKept] = UniqueIds[Row];
+		}
+		++NumKept;
+	}
+
+	const int32 NumRemoved = Handles.Num() - NumKept;
+	Handles.SetNum(NumKept, EAllowShrinking::No);
+	NameIds.SetNum(NumKept, EAllowShrinking::No);
+	NameNumbers.SetNum(NumKept, EAllowShrinking::No);
+	ClassNameIds.SetNum(NumKept, EAllowShrinking::No);
+	UniqueIds.SetNum(NumKept, EAllowShrinking::No);
+	return NumRemoved;
+}
+
+void FUBrowseObjectRows::Permute(TArrayView<const int32> Order)
+{
+	check(Order.Num() == Num());
+	PermuteArray(Handles, Order);
+	PermuteArray(NameIds, Order);
+	PermuteArray(NameNumbers, Order);
+	PermuteArray(ClassNameIds, Order);
+	PermuteArray(UniqueIds, Order);
+}
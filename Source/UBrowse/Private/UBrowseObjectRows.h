@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * The rows of the live object list, stored as parallel arrays with one entry per row in each.
+ *
+ * A row is an 8 byte weak handle (GUObjectArray index + serial number), which is also what the
+ * list view holds as its item, plus the values the list is sorted by. Those are captured when the
+ * row is added so sorting never has to touch the objects.
+ */
+struct FUBrowseObjectRows
+{
+	/* Weak handle of each row's object, the list view's items */
+	TArray<TWeakObjectPtr<UObject>> Handles;
+
+	/* Comparison index and number of each row's object name */
+	TArray<FNameEntryId> NameIds;
+	TArray<int32> NameNumbers;
+
+	/* Comparison index of each row's class name */
+	TArray<FNameEntryId> ClassNameIds;
+
+	TArray<int32> UniqueIds;
+
+	int32 Num() const { return Handles.Num(); }
+
+	void Reset();
+
+	void Reserve(int32 NumRows);
+
+	/** Append a row for a live object */
+	void Add(UObject* Object);
+
+	/** Append copies of another store's rows from FirstRow on */
+	void Append(const FUBrowseObjectRows& Other, int32 FirstRow);
+
+	/**
+	 * Drop the rows whose object has been destroyed, keeping the order of the rest.
+	 *
+	 * @return The number of rows removed
+	 */
+	int32 RemoveStale();
+
+	/**
+	 * Reorder the rows.
+	 *
+	 * @param Order For each new row, the index of the old row it takes
+	 */
+	void Permute(TArrayView<const int32> Order);
+};
@@ -0,0 +1,244 @@
+#include "UBrowseObjectScanner.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "UBrowseClassHistogram.h"
+#include "UBrowseNameIndex.h"
+#include "UBrowseObjectTracker.h"
+#include "UBrowseStats.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectHash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Query"), STAT_UBrowse_Query, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Scan All"), STAT_UBrowse_ScanAll, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Time Sliced Scan Step"), STAT_UBrowse_ScanStep, STATGROUP_UBrowse);
+
+EUBrowseQueryPlan FUBrowseObjectScanner::PlanQuery(const FUBrowseObjectFilter& Filter, const FUBrowseQueryIndices& Indices)
+{
+	// direct inners and package contents are always a small slice of the object array
+	if (Filter.FilterOuter != nullptr)
+	{
+		return EUBrowseQueryPlan::OuterIndex;
+	}
+	if (Filter.FilterPackage != nullptr)
+	{
+		return EUBrowseQueryPlan::PackageIndex;
+	}
+	// a typed name is nearly always narrower than a class
+	const FString& IndexSubstring = Filter.GetIndexSubstring();
+	if (!IndexSubstring.IsEmpty() && (Indices.NameIndex != nullptr) && Indices.NameIndex->IsValid())
+	{
+		return EUBrowseQueryPlan::NameIndex;
+	}
+	const UClass* IndexClass = Filter.GetIndexClass();
+	if ((IndexClass != nullptr) && (IndexClass != UObject::StaticClass()))
+	{
+		// a broad class like UActorComponent touches most of the hash anyway, scanning the array linearly is faster then
+		const FUBrowseClassHistogram* Histogram = Indices.Histogram;
+		if ((Histogram != nullptr) && Histogram->IsValid())
+		{
+			const int32 Estimate = Histogram->GetInclusiveCount(IndexClass);
+			if (Estimate > Histogram->GetTotalCount() / ClassIndexMaxShareDivisor)
+			{
+				return EUBrowseQueryPlan::FullScan;
+			}
+		}
+		return EUBrowseQueryPlan::ClassIndex;
+	}
+	return EUBrowseQueryPlan::FullScan;
+}
+
+EUBrowseQueryPlan FUBrowseObjectScanner::Query(const FUBrowseObjectFilter& Filter, EUBrowseScanMode Mode, const FUBrowseQueryIndices& Indices, TArray<UObject*>& OutObjects, TArray<int32>* OutPending, FUBrowseScanStats* OutStats)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_Query);
+
+	const EUBrowseQueryPlan Plan = PlanQuery(Filter, Indices);
+	const EObjectFlags ExclusionFlags = Filter.GetExclusionFlags();
+
+	// loading objects are not excluded by the hash walk so they can be reported as pending, same as a scan does
+	FUBrowseScanStats IndexStats;
+	auto AddIndexIfMatching = [&Filter, &OutObjects, OutPending, &IndexStats](int32 ObjectIndex)
+	{
+		++IndexStats.NumVisited;
+		bool bNotReady = false;
+		UObject* Object = FUBrowseObjectTracker::ResolveObject(ObjectIndex, bNotReady);
+		if (Object == nullptr)
+		{
+			if (bNotReady && (OutPending != nullptr))
+			{
+				OutPending->Add(ObjectIndex);
+			}
+			return;
+		}
+		if (Filter.Matches(Object))
+		{
+			IndexStats.NumAllocations += OutObjects.Num() == OutObjects.Max() ? 1 : 0;
+			++IndexStats.NumMatched;
+			OutObjects.Add(Object);
+		}
+	};
+	auto AddIfMatching = [&AddIndexIfMatching](UObject* Object)
+	{
+		AddIndexIfMatching(GUObjectArray.ObjectToIndex(Object));
+	};
+
+	switch (Plan)
+	{
+	case EUBrowseQueryPlan::OuterIndex:
+		ForEachObjectWithOuter(Filter.FilterOuter, AddIfMatching, false, ExclusionFlags, EInternalObjectFlags::Unreachable);
+		break;
+	case EUBrowseQueryPlan::PackageIndex:
+		ForEachObjectWithPackage(Filter.FilterPackage, [&AddIfMatching](UObject* Object)
+		{
+			AddIfMatching(Object);
+			return true;
+		}, true, ExclusionFlags, EInternalObjectFlags::Unreachable);
+		break;
+	case EUBrowseQueryPlan::NameIndex:
+	{
+		TArray<int32> CandidateIndices;
+		Indices.NameIndex->Query(Filter.GetIndexSubstring(), CandidateIndices);
+		IndexStats.NumAllocations += CandidateIndices.Max() > 0 ? 1 : 0;
+		// same order a scan would produce
+		CandidateIndices.Sort();
+		for (int32 ObjectIndex : CandidateIndices)
+		{
+			AddIndexIfMatching(ObjectIndex);
+		}
+		break;
+	}
+	case EUBrowseQueryPlan::ClassIndex:
+		ForEachObjectOfClass(Filter.GetIndexClass(), AddIfMatching, true, ExclusionFlags, EInternalObjectFlags::Unreachable);
+		break;
+	default:
+		ScanAll(Filter, Mode, OutObjects, OutPending, OutStats);
+		break;
+	}
+	if (OutStats != nullptr)
+	{
+		OutStats->Accumulate(IndexStats);
+	}
+	return Plan;
+}
+
+void FUBrowseObjectScanner::ScanAll(const FUBrowseObjectFilter& Filter, EUBrowseScanMode Mode, TArray<UObject*>& OutObjects, TArray<int32>* OutPending, FUBrowseScanStats* OutStats)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_ScanAll);
+
+	// keep GC from purging objects while they are being looked at
+	FGCScopeGuard GCGuard;
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumObjects, ChunkSize);
+
+	if ((Mode == EUBrowseScanMode::Serial) || (NumChunks < 2) || !FApp::ShouldUseThreadingForPerformance())
+	{
+		ScanRange(Filter, 0, NumObjects, OutObjects, OutPending, OutStats);
+		return;
+	}
+
+	// one result buffer per chunk, merged in chunk order so the output matches a serial scan
+	struct FChunkResult
+	{
+		TArray<UObject*> Objects;
+		TArray<int32> Pending;
+		FUBrowseScanStats Stats;
+	};
+	TArray<FChunkResult> ChunkResults;
+	ChunkResults.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&Filter, &ChunkResults, NumObjects](int32 ChunkIndex)
+	{
+		const int32 FirstIndex = ChunkIndex * ChunkSize;
+		const int32 EndIndex = FMath::Min(FirstIndex + ChunkSize, NumObjects);
+		FChunkResult& Result = ChunkResults[ChunkIndex];
+		ScanRange(Filter, FirstIndex, EndIndex, Result.Objects, &Result.Pending, &Result.Stats);
+	});
+
+	int32 NumMatches = 0;
+	for (const FChunkResult& Chunk : ChunkResults)
+	{
+		NumMatches += Chunk.Objects.Num();
+	}
+	FUBrowseScanStats Stats;
+	Stats.NumAllocations += OutObjects.Max() < OutObjects.Num() + NumMatches ? 1 : 0;
+	OutObjects.Reserve(OutObjects.Num() + NumMatches);
+	for (const FChunkResult& Chunk : ChunkResults)
+	{
+		Stats.Accumulate(Chunk.Stats);
+		OutObjects.Append(Chunk.Objects);
+		if (OutPending != nullptr)
+		{
+			OutPending->Append(Chunk.Pending);
+		}
+	}
+	if (OutStats != nullptr)
+	{
+		OutStats->Accumulate(Stats);
+	}
+}
+
+void FUBrowseObjectScanner::ScanRange(const FUBrowseObjectFilter& Filter, int32 FirstIndex, int32 EndIndex, TArray<UObject*>& OutObjects, TArray<int32>* OutPending, FUBrowseScanStats* OutStats)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBrowse_ScanRange);
+
+	int32 NumMatched = 0;
+	int32 NumAllocations = 0;
+	for (int32 ObjectIndex = FirstIndex; ObjectIndex < EndIndex; ++ObjectIndex)
+	{
+		bool bNotReady = false;
+		UObject* Object = FUBrowseObjectTracker::ResolveObject(ObjectIndex, bNotReady);
+		if (bNotReady && (OutPending != nullptr))
+		{
+			OutPending->Add(ObjectIndex);
+		}
+		if ((Object != nullptr) && Filter.Matches(Object))
+		{
+			// a full array is exactly when Add reallocates
+			NumAllocations += OutObjects.Num() == OutObjects.Max() ? 1 : 0;
+			++NumMatched;
+			OutObjects.Add(Object);
+		}
+	}
+	if (OutStats != nullptr)
+	{
+		OutStats->NumVisited += FMath::Max(EndIndex - FirstIndex, 0);
+		OutStats->NumMatched += NumMatched;
+		OutStats->NumAllocations += NumAllocations;
+	}
+}
+
+FUBrowseTimeSlicedScan::FUBrowseTimeSlicedScan(const FUBrowseObjectFilter& InFilter)
+	: Filter(InFilter)
+{
+}
+
+bool FUBrowseTimeSlicedScan::Step(double BudgetSeconds, TArray<UObject*>& OutObjects, TArray<int32>* OutPending)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_ScanStep);
+
+	const double StartTime = FPlatformTime::Seconds();
+	while (!bComplete)
+	{
+		// the array may have grown since the last step, anything past the old end is simply scanned as well
+		const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+		const int32 EndIndex = FMath::Min(NextIndex + SlotsPerTimeCheck, NumObjects);
+		FUBrowseObjectScanner::ScanRange(Filter, NextIndex, EndIndex, OutObjects, OutPending, &Stats);
+		NextIndex = EndIndex;
+		bComplete = NextIndex >= NumObjects;
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+	ElapsedSeconds += FPlatformTime::Seconds() - StartTime;
+	return bComplete;
+}
+
+float FUBrowseTimeSlicedScan::GetProgress() const
+{
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	return (bComplete || NumObjects == 0) ? 1.0f : FMath::Min(float(NextIndex) / float(NumObjects), 1.0f);
+}
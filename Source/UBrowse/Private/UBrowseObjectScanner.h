@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UBrowseObjectFilter.h"
+
+class FUBrowseClassHistogram;
+class FUBrowseNameIndex;
+
+enum class EUBrowseScanMode : uint8
+{
+	/* Walk GUObjectArray on the calling thread */
+	Serial,
+	/* Split GUObjectArray into chunks and filter them across the task graph */
+	Parallel
+};
+
+/** How a query finds its candidate objects before the filter is applied to them */
+enum class EUBrowseQueryPlan : uint8
+{
+	/* Every slot of GUObjectArray */
+	FullScan,
+	/* The UObjectHash class index, with derived classes */
+	ClassIndex,
+	/* The UObjectHash outer index */
+	OuterIndex,
+	/* The UObjectHash package index */
+	PackageIndex,
+	/* The name substring index */
+	NameIndex
+};
+
+/** What a query or scan looked at, for the browser's status line */
+struct FUBrowseScanStats
+{
+	/* Slots or index candidates checked against the filter */
+	int32 NumVisited = 0;
+	int32 NumMatched = 0;
+	/* Times a result buffer had to be allocated or grown */
+	int32 NumAllocations = 0;
+
+	void Accumulate(const FUBrowseScanStats& Other)
+	{
+		NumVisited += Other.NumVisited;
+		NumMatched += Other.NumMatched;
+		NumAllocations += Other.NumAllocations;
+	}
+};
+
+/** Indices a query may be planned against, any of them can be missing */
+struct FUBrowseQueryIndices
+{
+	/* Instance counts used to estimate how narrow a class filter is */
+	const FUBrowseClassHistogram* Histogram = nullptr;
+	/* Substring index over object names */
+	const FUBrowseNameIndex* NameIndex = nullptr;
+};
+
+/**
+ * Finds the live objects matching a filter, either through the UObjectHash indices or by walking GUObjectArray directly.
+ */
+class FUBrowseObjectScanner
+{
+public:
+	/** A class index lookup is only planned when the histogram expects it to return less than this share of all objects */
+	static constexpr int32 ClassIndexMaxShareDivisor = 4;
+
+	/**
+	 * Pick the cheapest way to find the candidates for a filter.
+	 *
+	 * @param Filter  The filter to plan for
+	 * @param Indices The indices available to the query
+	 */
+	static EUBrowseQueryPlan PlanQuery(const FUBrowseObjectFilter& Filter, const FUBrowseQueryIndices& Indices = FUBrowseQueryIndices());
+
+	/**
+	 * Plan and run a query, falling back to a full scan only when no index narrows it.
+	 *
+	 * @param Filter     Filter every candidate must pass
+	 * @param Mode       Scan mode used if the plan is a full scan
+	 * @param Indices    The indices available to the query
+	 * @param OutObjects Receives the matching objects
+	 * @param OutPending Optionally receives the slots of objects still being loaded, to be checked again later
+	 * @param OutStats   Optionally accumulates what the query looked at
+	 * @return The plan that was used
+	 */
+	static EUBrowseQueryPlan Query(const FUBrowseObjectFilter& Filter, EUBrowseScanMode Mode, const FUBrowseQueryIndices& Indices, TArray<UObject*>& OutObjects, TArray<int32>* OutPending = nullptr, FUBrowseScanStats* OutStats = nullptr);
+
+	/** Number of GUObjectArray slots one parallel task filters */
+	static constexpr int32 ChunkSize = 16 * 1024;
+
+	/**
+	 * Scan every live object. Results are appended in GUObjectArray order whichever mode is used.
+	 *
+	 * @param Filter     Filter to apply to each object
+	 * @param Mode       Serial, or Parallel which falls back to serial for arrays smaller than two chunks
+	 * @param OutObjects Receives the matching objects
+	 * @param OutPending Optionally receives the slots of objects still being loaded
+	 * @param OutStats   Optionally accumulates what the scan looked at
+	 */
+	static void ScanAll(const FUBrowseObjectFilter& Filter, EUBrowseScanMode Mode, TArray<UObject*>& OutObjects, TArray<int32>* OutPending = nullptr, FUBrowseScanStats* OutStats = nullptr);
+
+	/** Filter the GUObjectArray slots [FirstIndex, EndIndex), safe to call from worker threads while GC is locked out */
+	static void ScanRange(const FUBrowseObjectFilter& Filter, int32 FirstIndex, int32 EndIndex, TArray<UObject*>& OutObjects, TArray<int32>* OutPending = nullptr, FUBrowseScanStats* OutStats = nullptr);
+};
+
+/**
+ * A full scan spread across frames, each step walks GUObjectArray until its time budget runs out.
+ * Objects created or destroyed between steps are not tracked here, pair it with an FUBrowseObjectTracker.
+ */
+class FUBrowseTimeSlicedScan
+{
+public:
+	/** Slots scanned between two looks at the clock */
+	static constexpr int32 SlotsPerTimeCheck = 4096;
+
+	explicit FUBrowseTimeSlicedScan(const FUBrowseObjectFilter& InFilter);
+
+	/**
+	 * Scan the next slots until the budget is used up.
+	 *
+	 * @param BudgetSeconds Time this step may take, at least SlotsPerTimeCheck slots are always scanned
+	 * @param OutObjects    Receives the matching objects found in this step
+	 * @param OutPending    Optionally receives the slots of objects still being loaded
+	 * @return True once the end of the object array has been reached
+	 */
+	bool Step(double BudgetSeconds, TArray<UObject*>& OutObjects, TArray<int32>* OutPending = nullptr);
+
+	bool IsComplete() const { return bComplete; }
+
+	/** Share of the object array scanned so far, from 0 to 1 */
+	float GetProgress() const;
+
+	const FUBrowseObjectFilter& GetFilter() const { return Filter; }
+
+	/** What the steps so far looked at */
+	const FUBrowseScanStats& GetStats() const { return Stats; }
+
+	/** Time spent inside the steps so far */
+	double GetElapsedSeconds() const { return ElapsedSeconds; }
+
+private:
+	FUBrowseObjectFilter Filter;
+
+	FUBrowseScanStats Stats;
+	double ElapsedSeconds = 0.0;
+
+	/* First slot the next step scans */
+	int32 NextIndex = 0;
+
+	bool bComplete = false;
+};
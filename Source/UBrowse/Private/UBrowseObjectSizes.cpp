@@ -0,0 +1,102 @@
+#include "UBrowseObjectSizes.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Class.h"
+#include "UObject/Object.h"
+#include "UObject/ResourceSize.h"
+#include "UBrowseStats.h"
+
+int64 FUBrowseObjectSizes::MeasureExclusive(UObject* Object)
+{
+	FResourceSizeEx ExclusiveSize(EResourceSizeMode::Exclusive);
+	Object->GetResourceSizeEx(ExclusiveSize);
+	return int64(Object->GetClass()->GetPropertiesSize()) + int64(ExclusiveSize.GetTotalMemoryBytes());
+}
+
+FUBrowseObjectSize FUBrowseObjectSizes::Measure(UObject* Object)
+{
+	const int64 PropertiesSize = Object->GetClass()->GetPropertiesSize();
+
+	FResourceSizeEx ExclusiveSize(EResourceSizeMode::Exclusive);
+	Object->GetResourceSizeEx(ExclusiveSize);
+	FResourceSizeEx InclusiveSize(EResourceSizeMode::EstimatedTotal);
+	Object->GetResourceSizeEx(InclusiveSize);
+
+	FUBrowseObjectSize Size;
+	Size.Exclusive = PropertiesSize + int64(ExclusiveSize.GetTotalMemoryBytes());
+	Size.Inclusive = FMath::Max(PropertiesSize + int64(InclusiveSize.GetTotalMemoryBytes()), Size.Exclusive);
+	return Size;
+}
+
+void FUBrowseObjectSizes::BeginPass(TArrayView<const TWeakObjectPtr<UObject>> Objects)
+{
+	PassObjects.Reset(Objects.Num());
+	PassObjects.Append(Objects.GetData(), Objects.Num());
+	NextObject = 0;
+	bPassActive = true;
+	PendingClassTotals.Reset();
+	PendingPassTotal = FUBrowseSizeTotal();
+}
+
+DECLARE_CYCLE_STAT(TEXT("Measure Sizes"), STAT_UBrowse_MeasureSizes, STATGROUP_UBrowse);
+
+bool FUBrowseObjectSizes::Step(double BudgetSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_MeasureSizes);
+
+	const double StartTime = FPlatformTime::Seconds();
+	NumMeasuredLastStep = 0;
+	while (NextObject < PassObjects.Num())
+	{
+		const int32 EndObject = FMath::Min(NextObject + ObjectsPerTimeCheck, PassObjects.Num());
+		for (; NextObject < EndObject; ++NextObject)
+		{
+			const TWeakObjectPtr<UObject>& Handle = PassObjects[NextObject];
+			UObject* Object = Handle.Get();
+			// objects still loading have nothing sensible to report yet, a later pass picks them up
+			if ((Object == nullptr) || Object->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad | RF_BeginDestroyed))
+			{
+				continue;
+			}
+
+			const FUBrowseObjectSize* Size = Sizes.Find(Handle);
+			if (Size == nullptr)
+			{
+				Size = &Sizes.Add(Handle, Measure(Object));
+				++NumMeasuredLastStep;
+			}
+			PendingClassTotals.FindOrAdd(Object->GetClass()).Add(*Size);
+			PendingPassTotal.Add(*Size);
+		}
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	if (NextObject < PassObjects.Num())
+	{
+		return false;
+	}
+	if (bPassActive)
+	{
+		ClassTotals = MoveTemp(PendingClassTotals);
+		PassTotal = PendingPassTotal;
+		PassObjects.Empty();
+		NextObject = 0;
+		PendingClassTotals.Reset();
+		bPassActive = false;
+	}
+	return true;
+}
+
+void FUBrowseObjectSizes::RemoveStale()
+{
+	for (auto It = Sizes.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid(true))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/** Memory attributed to an object, in bytes */
+struct FUBrowseObjectSize
+{
+	/* The object's own resources plus its class's property block */
+	int64 Exclusive = 0;
+	/* As Exclusive, plus what GetResourceSizeEx estimates its subobjects and referenced resources add */
+	int64 Inclusive = 0;
+};
+
+/** Sizes summed over a set of objects */
+struct FUBrowseSizeTotal
+{
+	FUBrowseObjectSize Size;
+	int32 NumObjects = 0;
+
+	void Add(const FUBrowseObjectSize& ObjectSize)
+	{
+		Size.Exclusive += ObjectSize.Exclusive;
+		Size.Inclusive += ObjectSize.Inclusive;
+		++NumObjects;
+	}
+};
+
+/**
+ * Memory sizes of the listed objects, measured a slice at a time on the game thread.
+ *
+ * GetResourceSizeEx can be slow (textures and meshes walk their render data), so a published list is
+ * handed over whole and Step measures as many objects as fit the budget each frame. Sizes are cached
+ * by weak handle (object index + serial number) and survive later passes, a new object in a reused slot
+ * is measured afresh. Per class and list totals are summed over each pass and replace the previous
+ * pass's totals once it completes, so they never show a half counted list.
+ */
+class FUBrowseObjectSizes
+{
+public:
+	/* Objects measured between two checks of the clock */
+	static constexpr int32 ObjectsPerTimeCheck = 64;
+
+	/** Measure an object now */
+	static FUBrowseObjectSize Measure(UObject* Object);
+
+	/** Measure only the exclusive size of an object now, half the work of Measure */
+	static int64 MeasureExclusive(UObject* Object);
+
+	/** Start a pass over these objects, dropping the unfinished pass if any */
+	void BeginPass(TArrayView<const TWeakObjectPtr<UObject>> Objects);
+
+	/**
+	 * Measure objects of the current pass until it completes or the time is up.
+	 *
+	 * @return True once the pass is complete
+	 */
+	bool Step(double BudgetSeconds);
+
+	bool IsPassComplete() const { return !bPassActive; }
+
+	/** @return Number of objects the last Step had to measure, rather than find cached */
+	int32 GetNumMeasuredLastStep() const { return NumMeasuredLastStep; }
+
+	/** @return The cached size of an object, null if it has not been measured yet */
+	const FUBrowseObjectSize* Find(const TWeakObjectPtr<UObject>& Object) const { return Sizes.Find(Object); }
+
+	/** @return Totals over the objects of exactly this class in the last completed pass */
+	const FUBrowseSizeTotal* FindClassTotal(const UClass* Class) const { return ClassTotals.Find(Class); }
+
+	/** @return Totals over every object of the last completed pass */
+	const FUBrowseSizeTotal& GetPassTotal() const { return PassTotal; }
+
+	/** Forget the sizes of objects that have been destroyed */
+	void RemoveStale();
+
+private:
+	TMap<TWeakObjectPtr<UObject>, FUBrowseObjectSize> Sizes;
+
+	/* The pass being measured */
+	TArray<TWeakObjectPtr<UObject>> PassObjects;
+	int32 NextObject = 0;
+	int32 NumMeasuredLastStep = 0;
+	bool bPassActive = false;
+	TMap<const UClass*, FUBrowseSizeTotal> PendingClassTotals;
+	FUBrowseSizeTotal PendingPassTotal;
+
+	/* Results of the last completed pass */
+	TMap<const UClass*, FUBrowseSizeTotal> ClassTotals;
+	FUBrowseSizeTotal PassTotal;
+};
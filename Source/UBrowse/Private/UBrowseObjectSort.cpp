@@ -0,0 +1,204 @@
+#include "UBrowseObjectSort.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/App.h"
+#include "UBrowseStats.h"
+
+namespace
+{
+	struct FSortKeyLess
+	{
+		TArrayView<const FUBrowseSortColumn> Columns;
+
+		static int32 CompareColumn(const FUBrowseSortKey& A, const FUBrowseSortKey& B, EQuerySortMode::Type Mode)
+		{
+			switch (Mode)
+			{
+			case EQuerySortMode::ByName:
+				return A.NameRank != B.NameRank ? (A.NameRank < B.NameRank ? -1 : 1) : (A.Number < B.Number ? -1 : (A.Number > B.Number ? 1 : 0));
+			case EQuerySortMode::ByType:
+				return A.ClassRank < B.ClassRank ? -1 : (A.ClassRank > B.ClassRank ? 1 : 0);
+			case EQuerySortMode::ByNumber:
+				return A.Number < B.Number ? -1 : (A.Number > B.Number ? 1 : 0);
+			case EQuerySortMode::BySize:
+				return A.Size < B.Size ? -1 : (A.Size > B.Size ? 1 : 0);
+			default:
+				return A.UniqueId < B.UniqueId ? -1 : (A.UniqueId > B.UniqueId ? 1 : 0);
+			}
+		}
+
+		FORCEINLINE bool operator()(const FUBrowseSortKey& A, const FUBrowseSortKey& B) const
+		{
+			for (const FUBrowseSortColumn& Column : Columns)
+			{
+				const int32 Result = CompareColumn(A, B, Column.Mode);
+				if (Result != 0)
+				{
+					return Column.Direction == EColumnSortMode::Descending ? Result > 0 : Result < 0;
+				}
+			}
+			if (A.UniqueId != B.UniqueId)
+			{
+				return A.UniqueId < B.UniqueId;
+			}
+			return A.Row < B.Row;
+		}
+	};
+
+	/* Lexical rank of each distinct name */
+	TMap<FNameEntryId, int32> RankNames(TArrayView<const FNameEntryId> NameIds)
+	{
+		TMap<FNameEntryId, int32> Ranks;
+		for (FNameEntryId NameId : NameIds)
+		{
+			Ranks.Add(NameId, 0);
+		}
+
+		TArray<FNameEntryId> DistinctNames;
+		Ranks.GenerateKeyArray(DistinctNames);
+		Algo::Sort(DistinctNames, [](FNameEntryId A, FNameEntryId B) { return A.CompareLexical(B) < 0; });
+		for (int32 Rank = 0; Rank < DistinctNames.Num(); ++Rank)
+		{
+			Ranks[DistinctNames[Rank]] = Rank;
+		}
+		return Ranks;
+	}
+
+	/** Sort chunks of the array in parallel, then merge neighbouring runs in parallel passes */
+	template <typename ElementType, typename PredicateType>
+	void ParallelMergeSort(TArray<ElementType>& Elements, const PredicateType& Predicate)
+	{
+		const int32 Num = Elements.Num();
+		const int32 NumChunks = FMath::Clamp<int32>(FMath::RoundUpToPowerOfTwo(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1), 2, 64);
+		const int32 ChunkLength = FMath::DivideAndRoundUp(Num, NumChunks);
+
+		ParallelFor(NumChunks, [&Elements, &Predicate, Num, ChunkLength](int32 ChunkIndex)
+		{
+			const int32 First = ChunkIndex * ChunkLength;
+			const int32 End = FMath::Min(First + ChunkLength, Num);
+			if (First < End)
+			{
+				TArrayView<ElementType> Chunk(Elements.GetData() + First, End - First);
+				Algo::Sort(Chunk, Predicate);
+			}
+		});
+
+		TArray<ElementType> Scratch;
+		Scratch.SetNumUninitialized(Num);
+		TArray<ElementType>* Source = &Elements;
+		TArray<ElementType>* Dest = &Scratch;
+		for (int32 RunLength = ChunkLength; RunLength < Num; RunLength *= 2)
+		{
+			const int32 NumMerges = FMath::DivideAndRoundUp(Num, 2 * RunLength);
+			ParallelFor(NumMerges, [Source, Dest, &Predicate, Num, RunLength](int32 MergeIndex)
+			{
+				const int32 First = MergeIndex * 2 * RunLength;
+				const int32 Mid = FMath::Min(First + RunLength, Num);
+				const int32 End = FMath::Min(First + 2 * RunLength, Num);
+				const ElementType* SourceData = Source->GetData();
+				ElementType* DestData = Dest->GetData();
+				int32 Left = First;
+				int32 Right = Mid;
+				int32 Out = First;
+				while (Left < Mid && Right < End)
+				{
+					DestData[Out++] = Predicate(SourceData[Right], SourceData[Left]) ? SourceData[Right++] : SourceData[Left++];
+				}
+				while (Left < Mid)
+				{
+					DestData[Out++] = SourceData[Left++];
+				}
+				while (Right < End)
+				{
+					DestData[Out++] = SourceData[Right++];
+				}
+			});
+			Swap(Source, Dest);
+		}
+
+		if (Source != &Elements)
+		{
+			Elements = MoveTemp(*Source);
+		}
+	}
+}
+
+DECLARE_CYCLE_STAT(TEXT("Build Sort Keys"), STAT_UBrowse_BuildKeys, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Sort Keys"), STAT_UBrowse_SortKeys, STATGROUP_UBrowse);
+
+void FUBrowseObjectSorter::BuildKeys(const FUBrowseObjectRows& Rows, TArray<FUBrowseSortKey>& OutKeys, const FUBrowseObjectSizes* Sizes)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_BuildKeys);
+
+	const int32 NumRows = Rows.Num();
+	OutKeys.SetNumUninitialized(NumRows);
+
+	// the distinct names and class names are ranked once each, rows only look their rank up
+	const TMap<FNameEntryId, int32> NameRanks = RankNames(Rows.NameIds);
+	const TMap<FNameEntryId, int32> ClassRanks = RankNames(Rows.ClassNameIds);
+
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		FUBrowseSortKey& Key = OutKeys[Row];
+		Key.NameRank = NameRanks.FindChecked(Rows.NameIds[Row]);
+		Key.Number = Rows.NameNumbers[Row];
+		Key.ClassRank = ClassRanks.FindChecked(Rows.ClassNameIds[Row]);
+		Key.UniqueId = Rows.UniqueIds[Row];
+		const FUBrowseObjectSize* Size = Sizes != nullptr ? Sizes->Find(Rows.Handles[Row]) : nullptr;
+		Key.Size = Size != nullptr ? Size->Exclusive : -1;
+		Key.Row = Row;
+	}
+}
+
+void FUBrowseObjectSorter::SortKeys(TArray<FUBrowseSortKey>& Keys, TArrayView<const FUBrowseSortColumn> Columns, bool bParallel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_SortKeys);
+
+	const FSortKeyLess Predicate{ Columns };
+	if (bParallel && (Keys.Num() >= ParallelSortThreshold) && FApp::ShouldUseThreadingForPerformance())
+	{
+		ParallelMergeSort(Keys, Predicate);
+	}
+	else
+	{
+		Algo::Sort(Keys, Predicate);
+	}
+}
+
+bool FUBrowseObjectSorter::CanCompareRows(TArrayView<const FUBrowseSortColumn> Columns)
+{
+	// sizes arrive after the rows are added and are not captured with them
+	return !Columns.ContainsByPredicate([](const FUBrowseSortColumn& Column) { return Column.Mode == EQuerySortMode::BySize; });
+}
+
+int32 FUBrowseObjectSorter::CompareRows(const FUBrowseObjectRows& RowsA, int32 RowA, const FUBrowseObjectRows& RowsB, int32 RowB, TArrayView<const FUBrowseSortColumn> Columns)
+{
+	auto CompareInts = [](int32 A, int32 B) { return A < B ? -1 : (A > B ? 1 : 0); };
+
+	// ranks are only comparable within one key build, so names are compared directly, which orders them the same way
+	for (const FUBrowseSortColumn& Column : Columns)
+	{
+		int32 Result = 0;
+		switch (Column.Mode)
+		{
+		case EQuerySortMode::ByName:
+			Result = RowsA.NameIds[RowA] != RowsB.NameIds[RowB] ? RowsA.NameIds[RowA].CompareLexical(RowsB.NameIds[RowB]) : CompareInts(RowsA.NameNumbers[RowA], RowsB.NameNumbers[RowB]);
+			break;
+		case EQuerySortMode::ByType:
+			Result = RowsA.ClassNameIds[RowA] != RowsB.ClassNameIds[RowB] ? RowsA.ClassNameIds[RowA].CompareLexical(RowsB.ClassNameIds[RowB]) : 0;
+			break;
+		case EQuerySortMode::ByNumber:
+			Result = CompareInts(RowsA.NameNumbers[RowA], RowsB.NameNumbers[RowB]);
+			break;
+		default:
+			Result = CompareInts(RowsA.UniqueIds[RowA], RowsB.UniqueIds[RowB]);
+			break;
+		}
+		if (Result != 0)
+		{
+			return Column.Direction == EColumnSortMode::Descending ? -Result : Result;
+		}
+	}
+	return CompareInts(RowsA.UniqueIds[RowA], RowsB.UniqueIds[RowB]);
+}
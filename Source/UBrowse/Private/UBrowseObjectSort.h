@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Types/SlateEnums.h"
+#include "UBrowseObjectRows.h"
+#include "UBrowseObjectSizes.h"
+#include "Widgets/Views/SHeaderRow.h"
+
+namespace EQuerySortMode
+{
+enum Type
+{
+    ByName,
+    ByType,
+    ByNumber,
+    ByID,
+    BySize
+};
+}
+
+/** One column of a multi-column sort */
+struct FUBrowseSortColumn
+{
+	EQuerySortMode::Type Mode = EQuerySortMode::ByName;
+	EColumnSortMode::Type Direction = EColumnSortMode::Ascending;
+
+	bool operator==(const FUBrowseSortColumn& Other) const { return Mode == Other.Mode && Direction == Other.Direction; }
+	bool operator!=(const FUBrowseSortColumn& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Compact per-row sort key, so comparisons never touch the objects or build strings.
+ * Names and classes are replaced by their lexical rank among the distinct values in the list.
+ */
+struct FUBrowseSortKey
+{
+	int32 NameRank;
+	int32 Number;
+	int32 ClassRank;
+	int32 UniqueId;
+	/* Exclusive size, -1 while unmeasured so those rows gather at the small end */
+	int64 Size;
+	/* Position of the row before sorting */
+	int32 Row;
+};
+
+class FUBrowseObjectSorter
+{
+public:
+	/** Lists at least this long are sorted in parallel chunks and merged */
+	static constexpr int32 ParallelSortThreshold = 64 * 1024;
+
+	/**
+	 * Build one key per row from the sort values the rows captured.
+	 *
+	 * @param Rows    The rows to key, Row is set to the index in the store
+	 * @param OutKeys Receives the keys
+	 * @param Sizes   Measured object sizes, only needed to sort by size
+	 */
+	static void BuildKeys(const FUBrowseObjectRows& Rows, TArray<FUBrowseSortKey>& OutKeys, const FUBrowseObjectSizes* Sizes = nullptr);
+
+	/**
+	 * Sort keys by the given columns in priority order, ties broken by unique id so the order is stable across refreshes.
+	 *
+	 * @param Keys      The keys to sort in place
+	 * @param Columns   Sort columns, primary first
+	 * @param bParallel Allow sorting large lists across the task graph
+	 */
+	static void SortKeys(TArray<FUBrowseSortKey>& Keys, TArrayView<const FUBrowseSortColumn> Columns, bool bParallel = true);
+
+	/** @return False if the columns depend on values the rows do not capture, so CompareRows cannot order them */
+	static bool CanCompareRows(TArrayView<const FUBrowseSortColumn> Columns);
+
+	/**
+	 * Compare two rows, possibly from different stores, in the order SortKeys puts them.
+	 *
+	 * @return Negative if RowA sorts first, positive if RowB does, 0 if they share every sort value and unique id
+	 */
+	static int32 CompareRows(const FUBrowseObjectRows& RowsA, int32 RowA, const FUBrowseObjectRows& RowsB, int32 RowB, TArrayView<const FUBrowseSortColumn> Columns);
+};
@@ -0,0 +1,129 @@
+#include "UBrowseObjectTracker.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/Object.h"
+
+FUBrowseObjectTracker::FUBrowseObjectTracker(int32 InMaxPendingChanges)
+	: MaxPendingChanges(InMaxPendingChanges)
+{
+}
+
+FUBrowseObjectTracker::~FUBrowseObjectTracker()
+{
+	StopTracking();
+}
+
+void FUBrowseObjectTracker::StartTracking()
+{
+	if (!bTracking)
+	{
+		GUObjectArray.AddUObjectCreateListener(this);
+		GUObjectArray.AddUObjectDeleteListener(this);
+		bTracking = true;
+	}
+}
+
+void FUBrowseObjectTracker::StopTracking()
+{
+	if (bTracking)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+		bTracking = false;
+	}
+	Reset();
+}
+
+void FUBrowseObjectTracker::Reset()
+{
+	FScopeLock Lock(&PendingLock);
+	PendingCreated.Reset();
+	PendingDeleted.Reset();
+	bOverflowed = false;
+}
+
+bool FUBrowseObjectTracker::HasChanges() const
+{
+	FScopeLock Lock(&PendingLock);
+	return bOverflowed || PendingCreated.Num() > 0 || PendingDeleted.Num() > 0;
+}
+
+bool FUBrowseObjectTracker::ConsumeChanges(TArray<int32>& OutCreated, TArray<int32>& OutDeleted)
+{
+	FScopeLock Lock(&PendingLock);
+	if (bOverflowed)
+	{
+		PendingCreated.Reset();
+		PendingDeleted.Reset();
+		bOverflowed = false;
+		return false;
+	}
+	OutCreated = MoveTemp(PendingCreated);
+	OutDeleted = MoveTemp(PendingDeleted);
+	PendingCreated.Reset();
+	PendingDeleted.Reset();
+	return true;
+}
+
+void FUBrowseObjectTracker::DeferCreated(int32 Index)
+{
+	FScopeLock Lock(&PendingLock);
+	if (!bOverflowed)
+	{
+		PendingCreated.Add(Index);
+	}
+}
+
+UObject* FUBrowseObjectTracker::ResolveObject(int32 ObjectIndex, bool& bOutNotReady)
+{
+	bOutNotReady = false;
+	FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+	if ((ObjectItem == nullptr) || (ObjectItem->GetObject() == nullptr))
+	{
+		return nullptr;
+	}
+	if (ObjectItem->HasAnyFlags(EInternalObjectFlags::Unreachable))
+	{
+		return nullptr;
+	}
+	if (ObjectItem->HasAnyFlags(EInternalObjectFlags::Async | EInternalObjectFlags_AsyncLoading))
+	{
+		bOutNotReady = true;
+		return nullptr;
+	}
+	return static_cast<UObject*>(ObjectItem->GetObject());
+}
+
+void FUBrowseObjectTracker::RecordChange(TArray<int32>& Changes, int32 Index)
+{
+	FScopeLock Lock(&PendingLock);
+	if (bOverflowed)
+	{
+		return;
+	}
+	if (PendingCreated.Num() + PendingDeleted.Num() >= MaxPendingChanges)
+	{
+		// a level load or GC of this size is cheaper to pick up with one rescan
+		PendingCreated.Empty();
+		PendingDeleted.Empty();
+		bOverflowed = true;
+		return;
+	}
+	Changes.Add(Index);
+}
+
+void FUBrowseObjectTracker::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	RecordChange(PendingCreated, Index);
+}
+
+void FUBrowseObjectTracker::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	RecordChange(PendingDeleted, Index);
+}
+
+void FUBrowseObjectTracker::OnUObjectArrayShutdown()
+{
+	GUObjectArray.RemoveUObjectCreateListener(this);
+	GUObjectArray.RemoveUObjectDeleteListener(this);
+	bTracking = false;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/UObjectArray.h"
+
+/**
+ * Records which slots of GUObjectArray had objects created or deleted since it was last consumed,
+ * so views over the live objects can be brought up to date by deltas instead of full rescans.
+ *
+ * The listener callbacks can fire on any thread (async loading, GC purge) and only record the
+ * slot index; objects are resolved on the game thread when the changes are consumed.
+ */
+class FUBrowseObjectTracker
+	: public FUObjectArray::FUObjectCreateListener
+	, public FUObjectArray::FUObjectDeleteListener
+{
+public:
+	/** @param InMaxPendingChanges Past this many recorded changes the tracker gives up and asks for a rescan */
+	explicit FUBrowseObjectTracker(int32 InMaxPendingChanges = 256 * 1024);
+	virtual ~FUBrowseObjectTracker();
+
+	void StartTracking();
+	void StopTracking();
+	bool IsTracking() const { return bTracking; }
+
+	/** Drop everything recorded so far, used once a full scan has caught the consumer up */
+	void Reset();
+
+	/** @return true if anything was created or deleted since the last consume */
+	bool HasChanges() const;
+
+	/**
+	 * Hand the recorded slot indices to the caller and start a new batch.
+	 * Deletions must be applied before creations, a slot can be freed and reused within one batch.
+	 *
+	 * @return false if the changes overflowed and the caller should do a full rescan instead
+	 */
+	bool ConsumeChanges(TArray<int32>& OutCreated, TArray<int32>& OutDeleted);
+
+	/**
+	 * Put a created slot back into the pending batch, for objects that were still loading when consumed.
+	 */
+	void DeferCreated(int32 Index);
+
+	/**
+	 * @param bOutNotReady Set when the slot holds an object that is still being constructed or loaded
+	 * @return The object living at a slot, or null if it is gone, unreachable or not ready yet
+	 */
+	static UObject* ResolveObject(int32 ObjectIndex, bool& bOutNotReady);
+
+	static UObject* ResolveObject(int32 ObjectIndex)
+	{
+		bool bNotReady;
+		return ResolveObject(ObjectIndex, bNotReady);
+	}
+
+	//~ Begin FUObjectCreateListener / FUObjectDeleteListener Interface
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+	//~ End FUObjectCreateListener / FUObjectDeleteListener Interface
+
+private:
+	void RecordChange(TArray<int32>& Changes, int32 Index);
+
+	mutable FCriticalSection PendingLock;
+	TArray<int32> PendingCreated;
+	TArray<int32> PendingDeleted;
+	int32 MaxPendingChanges;
+	bool bOverflowed = false;
+	bool bTracking = false;
+};
@@ -0,0 +1,281 @@
+#include "UBrowseQuery.h"
+#include "Algo/StableSort.h"
+#include "UBrowseNameIndex.h"
+#include "UBrowseObjectFlags.h"
+#include "UObject/Class.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#define LOCTEXT_NAMESPACE "UBrowseQuery"
+
+namespace
+{
+	/* Split on whitespace outside of double quotes, the quotes are kept */
+	bool Tokenize(const FString& Text, TArray<FString>& OutTokens)
+	{
+		FString Token;
+		bool bInQuotes = false;
+		for (TCHAR Char : Text)
+		{
+			if (Char == TEXT('"'))
+			{
+				bInQuotes = !bInQuotes;
+			}
+			else if (!bInQuotes && FChar::IsWhitespace(Char))
+			{
+				if (!Token.IsEmpty())
+				{
+					OutTokens.Add(MoveTemp(Token));
+					Token.Reset();
+				}
+				continue;
+			}
+			Token.AppendChar(Char);
+		}
+		if (!Token.IsEmpty())
+		{
+			OutTokens.Add(MoveTemp(Token));
+		}
+		return !bInQuotes;
+	}
+
+	FString Unquote(const FString& Value)
+	{
+		if ((Value.Len() >= 2) && Value.StartsWith(TEXT("\"")) && Value.EndsWith(TEXT("\"")))
+		{
+			return Value.Mid(1, Value.Len() - 2);
+		}
+		return Value;
+	}
+
+	/* Accepts StaticMeshComponent, UStaticMeshComponent and /Script/Engine.StaticMeshComponent */
+	const UClass* FindQueryClass(const FString& Name)
+	{
+		if (Name.Contains(TEXT(".")))
+		{
+			return FindObject<UClass>(nullptr, *Name);
+		}
+		if (const UClass* Class = FindFirstObject<UClass>(*Name, EFindFirstObjectOptions::NativeFirst))
+		{
+			return Class;
+		}
+		const bool bHasPrefix = (Name.Len() > 1) && ((Name[0] == TEXT('U')) || (Name[0] == TEXT('A'))) && FChar::IsUpper(Name[1]);
+		return bHasPrefix ? FindFirstObject<UClass>(*Name.Mid(1), EFindFirstObjectOptions::NativeFirst) : nullptr;
+	}
+
+	bool ParseFlag(const FString& Token, FUBrowseQueryPredicate& FlagsPredicate, FText& OutError)
+	{
+		const bool bExclude = Token.StartsWith(TEXT("-"));
+		const FString Name = (bExclude || Token.StartsWith(TEXT("+"))) ? Token.Mid(1) : Token;
+		const FUBrowseFlagDescriptor* Flag = FUBrowseObjectFlags::Find(Name);
+		if (Flag == nullptr)
+		{
+			OutError = FText::Format(LOCTEXT("UnknownFlag", "Unknown flag '{0}'"), FText::FromString(Name));
+			return false;
+		}
+		if (bExclude)
+		{
+			FlagsPredicate.ExcludedFlags |= Flag->Flags;
+			FlagsPredicate.ExcludedInternalFlags |= Flag->InternalFlags;
+		}
+		else
+		{
+			FlagsPredicate.RequiredFlags |= Flag->Flags;
+			FlagsPredicate.RequiredInternalFlags |= Flag->InternalFlags;
+		}
+		return true;
+	}
+}
+
+bool FUBrowseQueryPredicate::Matches(const UObject* Object) const
+{
+	switch (Term)
+	{
+	case EUBrowseQueryTerm::Flags:
+	{
+		const EInternalObjectFlags InternalFlags = Object->GetInternalFlags();
+		return Object->HasAllFlags(RequiredFlags) && !Object->HasAnyFlags(ExcludedFlags)
+			&& EnumHasAllFlags(InternalFlags, RequiredInternalFlags) && !EnumHasAnyFlags(InternalFlags, ExcludedInternalFlags);
+	}
+	case EUBrowseQueryTerm::Class:
+		return Object->IsA(Class);
+	case EUBrowseQueryTerm::NameEquals:
+		return Object->GetFName() == Name;
+	case EUBrowseQueryTerm::Outer:
+		return (Object->GetOuter() != nullptr) && (Object->GetOuter()->GetFName() == Name);
+	case EUBrowseQueryTerm::Package:
+		return Object->GetPackage()->GetName().Contains(Text);
+	case EUBrowseQueryTerm::NameContains:
+		return Object->GetName().Contains(Text);
+	case EUBrowseQueryTerm::NameRegex:
+	{
+		const FString ObjectName = Object->GetName();
+		FRegexMatcher Matcher(*Pattern, ObjectName);
+		return Matcher.FindNext();
+	}
+	default:
+		return true;
+	}
+}
+
+TSharedPtr<const FUBrowseQuery> FUBrowseQuery::Compile(const FString& Text, FText& OutError)
+{
+	OutError = FText::GetEmpty();
+
+	TArray<FString> Tokens;
+	if (!Tokenize(Text, Tokens))
+	{
+		OutError = LOCTEXT("UnterminatedQuote", "Missing closing quote");
+		return nullptr;
+	}
+
+	TSharedRef<FUBrowseQuery> Query = MakeShared<FUBrowseQuery>();
+	FUBrowseQueryPredicate FlagsPredicate;
+	bool bHasFlags = false;
+	bool bInFlags = false;
+
+	for (const FString& Token : Tokens)
+	{
+		// flags:+Transient -CDO, the +/- terms after flags: belong to it
+		if (bInFlags && (Token.StartsWith(TEXT("+")) || Token.StartsWith(TEXT("-"))))
+		{
+			if (!ParseFlag(Token, FlagsPredicate, OutError))
+			{
+				return nullptr;
+			}
+			continue;
+		}
+		bInFlags = false;
+
+		int32 OperatorIndex = INDEX_NONE;
+		for (int32 CharIndex = 0; CharIndex < Token.Len(); ++CharIndex)
+		{
+			const TCHAR Char = Token[CharIndex];
+			if ((Char == TEXT('"')) || (Char == TEXT(':')) || (Char == TEXT('~')) || (Char == TEXT('=')))
+			{
+				OperatorIndex = Char == TEXT('"') ? INDEX_NONE : CharIndex;
+				break;
+			}
+		}
+
+		FUBrowseQueryPredicate Predicate;
+		if (OperatorIndex == INDEX_NONE)
+		{
+			Predicate.Term = EUBrowseQueryTerm::NameContains;
+			Predicate.Text = Unquote(Token);
+			Query->Predicates.Add(MoveTemp(Predicate));
+			continue;
+		}
+
+		const FString Key = Token.Left(OperatorIndex);
+		const TCHAR Operator = Token[OperatorIndex];
+		const FString Value = Unquote(Token.Mid(OperatorIndex + 1));
+		if ((Operator == TEXT('~')) && !Key.Equals(TEXT("name"), ESearchCase::IgnoreCase))
+		{
+			OutError = FText::Format(LOCTEXT("RegexOnlyOnName", "'{0}~' is not supported, only name~ takes a regular expression"), FText::FromString(Key));
+			return nullptr;
+		}
+
+		if (Key.Equals(TEXT("flags"), ESearchCase::IgnoreCase))
+		{
+			bHasFlags = true;
+			bInFlags = true;
+			if (!Value.IsEmpty() && !ParseFlag(Value, FlagsPredicate, OutError))
+			{
+				return nullptr;
+			}
+			continue;
+		}
+
+		if (Value.IsEmpty())
+		{
+			OutError = FText::Format(LOCTEXT("MissingValue", "'{0}' needs a value"), FText::FromString(Token));
+			return nullptr;
+		}
+
+		if (Key.Equals(TEXT("class"), ESearchCase::IgnoreCase))
+		{
+			Predicate.Term = EUBrowseQueryTerm::Class;
+			Predicate.Class = FindQueryClass(Value);
+			if (Predicate.Class == nullptr)
+			{
+				OutError = FText::Format(LOCTEXT("UnknownClass", "Unknown class '{0}'"), FText::FromString(Value));
+				return nullptr;
+			}
+		}
+		else if (Key.Equals(TEXT("outer"), ESearchCase::IgnoreCase))
+		{
+			Predicate.Term = EUBrowseQueryTerm::Outer;
+			Predicate.Name = FName(*Value);
+		}
+		else if (Key.Equals(TEXT("package"), ESearchCase::IgnoreCase))
+		{
+			Predicate.Term = EUBrowseQueryTerm::Package;
+			Predicate.Text = Value;
+		}
+		else if (Key.Equals(TEXT("name"), ESearchCase::IgnoreCase))
+		{
+			if (Operator == TEXT('~'))
+			{
+				Predicate.Term = EUBrowseQueryTerm::NameRegex;
+				Predicate.Pattern = MakeShared<FRegexPattern>(Value, ERegexPatternFlags::CaseInsensitive);
+			}
+			else if (Operator == TEXT('='))
+			{
+				Predicate.Term = EUBrowseQueryTerm::NameEquals;
+				Predicate.Name = FName(*Value);
+			}
+			else
+			{
+				Predicate.Term = EUBrowseQueryTerm::NameContains;
+				Predicate.Text = Value;
+			}
+		}
+		else
+		{
+			OutError = FText::Format(LOCTEXT("UnknownTerm", "Unknown term '{0}', expected class, outer, package, name or flags"), FText::FromString(Key));
+			return nullptr;
+		}
+		Query->Predicates.Add(MoveTemp(Predicate));
+	}
+
+	if (bHasFlags)
+	{
+		FlagsPredicate.Term = EUBrowseQueryTerm::Flags;
+		Query->Predicates.Add(MoveTemp(FlagsPredicate));
+	}
+
+	// cheapest first, terms of the same kind keep the order they were typed in
+	Algo::StableSort(Query->Predicates, [](const FUBrowseQueryPredicate& A, const FUBrowseQueryPredicate& B)
+	{
+		return A.Term < B.Term;
+	});
+
+	for (const FUBrowseQueryPredicate& Predicate : Query->Predicates)
+	{
+		if ((Predicate.Term == EUBrowseQueryTerm::Class) && ((Query->IndexClass == nullptr) || Predicate.Class->IsChildOf(Query->IndexClass)))
+		{
+			Query->IndexClass = Predicate.Class;
+		}
+		else if ((Predicate.Term == EUBrowseQueryTerm::NameContains) && (Predicate.Text.Len() > Query->IndexSubstring.Len()) && FUBrowseNameIndex::CanQuery(Predicate.Text))
+		{
+			Query->IndexSubstring = Predicate.Text;
+		}
+	}
+
+	return Query;
+}
+
+bool FUBrowseQuery::Matches(const UObject* Object) const
+{
+	for (const FUBrowseQueryPredicate& Predicate : Predicates)
+	{
+		if (!Predicate.Matches(Object))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+#include "UObject/Object.h"
+
+/** Kinds of query term, in the order they are evaluated: cheapest first, string work last */
+enum class EUBrowseQueryTerm : uint8
+{
+	/* flags:+Transient -CDO, a couple of bit tests */
+	Flags,
+	/* class:StaticMeshComponent, IsA */
+	Class,
+	/* name=Foo, one FName compare */
+	NameEquals,
+	/* outer:PersistentLevel, one FName compare per object */
+	Outer,
+	/* package:Maps, builds the package name */
+	Package,
+	/* name:Foo or a bare word, builds the object name */
+	NameContains,
+	/* name~"Foo.*", builds the name and runs a regex */
+	NameRegex
+};
+
+/** One compiled term of a query */
+struct FUBrowseQueryPredicate
+{
+	EUBrowseQueryTerm Term = EUBrowseQueryTerm::Flags;
+
+	/* Class */
+	const UClass* Class = nullptr;
+
+	/* NameEquals, Outer */
+	FName Name;
+
+	/* NameContains, Package */
+	FString Text;
+
+	/* NameRegex */
+	TSharedPtr<FRegexPattern> Pattern;
+
+	/* Flags */
+	EObjectFlags RequiredFlags = RF_NoFlags;
+	EObjectFlags ExcludedFlags = RF_NoFlags;
+	EInternalObjectFlags RequiredInternalFlags = EInternalObjectFlags::None;
+	EInternalObjectFlags ExcludedInternalFlags = EInternalObjectFlags::None;
+
+	bool Matches(const UObject* Object) const;
+};
+
+/**
+ * A query typed into the object list filter box, for example
+ *   class:StaticMeshComponent outer:PersistentLevel flags:+Transient -CDO name~"Foo.*"
+ *
+ * Parsed once into a chain of predicates, every one of which must pass. Terms are reordered so the
+ * cheap ones reject objects before any string is built, and regex patterns are compiled up front.
+ * Bare words are name substrings, which keeps plain text working as it always has.
+ */
+class FUBrowseQuery
+{
+public:
+	/**
+	 * Parse a query.
+	 *
+	 * @param Text     The query text
+	 * @param OutError Set to a description of the first problem found
+	 * @return The compiled query, or null if the text could not be parsed
+	 */
+	static TSharedPtr<const FUBrowseQuery> Compile(const FString& Text, FText& OutError);
+
+	/** @return true if the object passes every term */
+	bool Matches(const UObject* Object) const;
+
+	/** @return The narrowest class term, for planning a class index lookup, or null */
+	const UClass* GetIndexClass() const { return IndexClass; }
+
+	/** @return The longest name substring term, for planning a name index lookup, or empty */
+	const FString& GetIndexSubstring() const { return IndexSubstring; }
+
+	const TArray<FUBrowseQueryPredicate>& GetPredicates() const { return Predicates; }
+
+private:
+	TArray<FUBrowseQueryPredicate> Predicates;
+	const UClass* IndexClass = nullptr;
+	FString IndexSubstring;
+};
@@ -0,0 +1,267 @@
+#include "UBrowseReferenceIndex.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectArray.h"
+#include "UBrowseObjectTracker.h"
+#include "UBrowseStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Reference Index Gather"), STAT_UBrowse_ReferenceIndexGather, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Reference Index Invert"), STAT_UBrowse_ReferenceIndexInvert, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Find Path To Root"), STAT_UBrowse_FindPathToRoot, STATGROUP_UBrowse);
+
+TSharedRef<FUBrowseReferenceIndex> FUBrowseReferenceIndex::Gather()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_ReferenceIndexGather);
+
+	// objects are only safe to read while nothing else changes them, which the blocked game thread sees to, the same way reachability analysis does
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TSharedRef<FUBrowseReferenceIndex> Index = MakeShared<FUBrowseReferenceIndex>();
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+	Index->NumObjects = NumObjects;
+
+	// every chunk lists the references of its objects in slot order, so the chunks concatenate into the reference table
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumObjects, ObjectsPerChunk);
+	TArray<TArray<int32>> ChunkTargets;
+	ChunkTargets.SetNum(NumChunks);
+	Index->ReferenceOffsets.SetNumZeroed(NumObjects + 1);
+	Index->SlotSerials.Init(INDEX_NONE, NumObjects);
+
+	ParallelFor(NumChunks, [&ChunkTargets, &Index, NumObjects](int32 ChunkIndex)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UBrowse_ReferenceIndexChunk);
+
+		const int32 FirstIndex = ChunkIndex * ObjectsPerChunk;
+		const int32 EndIndex = FMath::Min(FirstIndex + ObjectsPerChunk, NumObjects);
+		TArray<int32>& Targets = ChunkTargets[ChunkIndex];
+		TArray<UObject*> References;
+		for (int32 ObjectIndex = FirstIndex; ObjectIndex < EndIndex; ++ObjectIndex)
+		{
+			UObject* Object = FUBrowseObjectTracker::ResolveObject(ObjectIndex);
+			if (Object == nullptr)
+			{
+				continue;
+			}
+
+			// tells the object gathered here apart from whatever takes its slot once it is freed. Only read, objects
+			// nothing holds a weak pointer to have none and are left without
+			Index->SlotSerials[ObjectIndex] = GUObjectArray.GetSerialNumber(ObjectIndex);
+
+			// a finder remembers everything it reported, so each object needs a fresh one
+			References.Reset();
+			FReferenceFinder Finder(References, nullptr, false, false, false, false);
+			Finder.FindReferences(Object);
+
+			const int32 NumTargetsBefore = Targets.Num();
+			for (UObject* Referenced : References)
+			{
+				const int32 ReferencedIndex = GUObjectArray.ObjectToIndex(Referenced);
+				if ((ReferencedIndex != ObjectIndex) && (ReferencedIndex >= 0) && (ReferencedIndex < NumObjects))
+				{
+					Targets.Add(ReferencedIndex);
+				}
+			}
+			// counts for now, turned into offsets below. Each slot is written by its own chunk only
+			Index->ReferenceOffsets[ObjectIndex + 1] = Targets.Num() - NumTargetsBefore;
+		}
+	});
+
+	int32 NumReferences = 0;
+	for (const TArray<int32>& Targets : ChunkTargets)
+	{
+		NumReferences += Targets.Num();
+	}
+	Index->ReferenceTargets.Reserve(NumReferences);
+	for (TArray<int32>& Targets : ChunkTargets)
+	{
+		Index->ReferenceTargets.Append(Targets);
+		Targets.Empty();
+	}
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		Index->ReferenceOffsets[ObjectIndex + 1] += Index->ReferenceOffsets[ObjectIndex];
+	}
+
+	Index->GatherSeconds = FPlatformTime::Seconds() - StartTime;
+	return Index;
+}
+
+void FUBrowseReferenceIndex::BuildReferencers()
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_ReferenceIndexInvert);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// invert by counting sort, walking the sources in slot order leaves every referencer row sorted
+	ReferencerOffsets.SetNumZeroed(NumObjects + 1);
+	for (int32 Target : ReferenceTargets)
+	{
+		++ReferencerOffsets[Target + 1];
+	}
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		ReferencerOffsets[ObjectIndex + 1] += ReferencerOffsets[ObjectIndex];
+	}
+
+	TArray<int32> WriteOffsets(ReferencerOffsets.GetData(), NumObjects);
+	ReferencerSources.SetNumUninitialized(ReferenceTargets.Num());
+	for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
+	{
+		for (int32 Target : GetReferences(ObjectIndex))
+		{
+			ReferencerSources[WriteOffsets[Target]++] = ObjectIndex;
+		}
+	}
+
+	BuildSeconds = GatherSeconds + (FPlatformTime::Seconds() - StartTime);
+}
+
+bool FUBrowseReferenceIndex::IsGathered(int32 ObjectIndex) const
+{
+	if ((ObjectIndex < 0) || (ObjectIndex >= NumObjects) || (SlotSerials[ObjectIndex] == INDEX_NONE))
+	{
+		return false;
+	}
+	// without a serial at the gather only a slot that has since been given one to a different object
+	// can be told apart, and that takes a weak pointer, so an unknown serial is taken as the same object
+	const int32 GatheredSerial = SlotSerials[ObjectIndex];
+	return (GatheredSerial == 0) || (GUObjectArray.GetSerialNumber(ObjectIndex) == GatheredSerial);
+}
+
+EUBrowseRootReason FUBrowseReferenceIndex::GetRootReason(const UObject* Object)
+{
+	if (Object->IsRooted())
+	{
+		return EUBrowseRootReason::RootSet;
+	}
+	if (GUObjectArray.IsDisregardForGC(Object))
+	{
+		return EUBrowseRootReason::DisregardForGC;
+	}
+	if (Object->HasAnyFlags(GARBAGE_COLLECTION_KEEPFLAGS))
+	{
+		return EUBrowseRootReason::KeepFlags;
+	}
+	return EUBrowseRootReason::None;
+}
+
+EUBrowseRootReason FUBrowseReferenceIndex::FindPathToRoot(int32 ObjectIndex, TArray<int32>& OutChain) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_FindPathToRoot);
+
+	OutChain.Reset();
+	if (!IsGathered(ObjectIndex))
+	{
+		return EUBrowseRootReason::None;
+	}
+
+	// slot each visited object was reached from, one step closer to ObjectIndex. All bits set is INDEX_NONE
+	TArray<int32> ReachedFrom;
+	ReachedFrom.SetNumUninitialized(NumObjects);
+	FMemory::Memset(ReachedFrom.GetData(), 0xff, NumObjects * sizeof(int32));
+	ReachedFrom[ObjectIndex] = ObjectIndex;
+
+	TArray<int32> Queue;
+	Queue.Add(ObjectIndex);
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 Current = Queue[Head];
+		const UObject* Object = FUBrowseObjectTracker::ResolveObject(Current);
+		if ((Object == nullptr) || !IsGathered(Current))
+		{
+			// objects that are gone keep nothing alive, and the rows of a reused slot describe the object that left it
+			continue;
+		}
+
+		const EUBrowseRootReason Reason = GetRootReason(Object);
+		if (Reason != EUBrowseRootReason::None)
+		{
+			for (int32 Slot = Current; ; Slot = ReachedFrom[Slot])
+			{
+				OutChain.Add(Slot);
+				if (Slot == ObjectIndex)
+				{
+					break;
+				}
+			}
+			return Reason;
+		}
+
+		for (int32 Referencer : GetReferencers(Current))
+		{
+			if (ReachedFrom[Referencer] == INDEX_NONE)
+			{
+				ReachedFrom[Referencer] = Current;
+				Queue.Add(Referencer);
+			}
+		}
+	}
+	return EUBrowseRootReason::None;
+}
+
+FUBrowseReferenceIndexCache::FUBrowseReferenceIndexCache()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FUBrowseReferenceIndexCache::OnPostGarbageCollect);
+}
+
+FUBrowseReferenceIndexCache::~FUBrowseReferenceIndexCache()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
+}
+
+TSharedPtr<const FUBrowseReferenceIndex> FUBrowseReferenceIndexCache::Request()
+{
+	check(IsInGameThread());
+
+	if (Index.IsValid() || bBuilding)
+	{
+		return Index;
+	}
+
+	bBuilding = true;
+	// gathered at the next pass over the game thread's tasks rather than in the middle of whatever asked, then inverted on a worker
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak()]()
+	{
+		TSharedPtr<FUBrowseReferenceIndexCache> This = WeakThis.Pin();
+		if (!This.IsValid())
+		{
+			return;
+		}
+
+		TSharedRef<FUBrowseReferenceIndex> GatheredIndex = FUBrowseReferenceIndex::Gather();
+		Async(EAsyncExecution::ThreadPool, [WeakThis, GatheredIndex, BuildGeneration = This->Generation]()
+		{
+			GatheredIndex->BuildReferencers();
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, GatheredIndex, BuildGeneration]()
+			{
+				if (TSharedPtr<FUBrowseReferenceIndexCache> This = WeakThis.Pin())
+				{
+					This->OnBuildComplete(GatheredIndex, BuildGeneration);
+				}
+			});
+		});
+	});
+	return nullptr;
+}
+
+void FUBrowseReferenceIndexCache::OnBuildComplete(TSharedRef<const FUBrowseReferenceIndex> BuiltIndex, uint32 BuildGeneration)
+{
+	bBuilding = false;
+
+	// a collection ran between the gather and now, the slots it refers to may hold other objects
+	if (BuildGeneration == Generation)
+	{
+		Index = BuiltIndex;
+	}
+	IndexReady.Broadcast();
+}
+
+void FUBrowseReferenceIndexCache::OnPostGarbageCollect()
+{
+	Index.Reset();
+	++Generation;
+}
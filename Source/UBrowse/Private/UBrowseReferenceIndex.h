@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Why garbage collection keeps an object whether or not anything references it */
+enum class EUBrowseRootReason : uint8
+{
+	None,
+	/* Added to the root set */
+	RootSet,
+	/* Part of the permanent object pool */
+	DisregardForGC,
+	/* Has a flag the collector keeps, RF_Standalone in the editor */
+	KeepFlags
+};
+
+/**
+ * Who references whom among the live objects, as two compressed sparse row tables over GUObjectArray
+ * slots: the references of each object and, inverted from those, its referencers.
+ *
+ * The references are gathered with FReferenceFinder by a parallel pass the game thread starts and waits
+ * on, so no object changes while it is read, the referencers are inverted from them afterwards on any
+ * thread. Slots are only stable until the next collection, so an index is thrown away then rather than
+ * updated. Objects created after the gather have no entries.
+ */
+class FUBrowseReferenceIndex
+{
+public:
+	/* Objects handed to each worker of the gather */
+	static constexpr int32 ObjectsPerChunk = 4096;
+
+	/** Gather the references of every live object, the referencers are left empty. Game thread only, blocks it until done */
+	static TSharedRef<FUBrowseReferenceIndex> Gather();
+
+	/** Invert the gathered references into the referencer table. Reads no objects, so safe to call from any thread */
+	void BuildReferencers();
+
+	/** Slots of the objects the object at a slot references, in no particular order */
+	TConstArrayView<int32> GetReferences(int32 ObjectIndex) const
+	{
+		return GetRow(ReferenceOffsets, ReferenceTargets, ObjectIndex);
+	}
+
+	/** Slots of the objects referencing the object at a slot, in slot order */
+	TConstArrayView<int32> GetReferencers(int32 ObjectIndex) const
+	{
+		return GetRow(ReferencerOffsets, ReferencerSources, ObjectIndex);
+	}
+
+	/** Number of GUObjectArray slots covered, objects created since the gather sit past the end */
+	int32 GetNumObjects() const { return NumObjects; }
+
+	/**
+	 * True if the object at a slot is the one its rows were gathered from, false once the slot was freed or reused.
+	 * A reuse only shows when the gathered object had a serial number, that is something held a weak pointer to it
+	 */
+	bool IsGathered(int32 ObjectIndex) const;
+
+	static EUBrowseRootReason GetRootReason(const UObject* Object);
+
+	/**
+	 * Breadth first search up the referencer table for the nearest object garbage collection keeps by itself.
+	 *
+	 * @param ObjectIndex Slot of the object to explain
+	 * @param OutChain    Receives the slots from the kept object (first) to ObjectIndex (last), each referencing the next. Empty if none was found
+	 * @return Why the first object of the chain is kept, None if nothing kept references the object
+	 */
+	EUBrowseRootReason FindPathToRoot(int32 ObjectIndex, TArray<int32>& OutChain) const;
+
+	int32 GetNumReferences() const { return ReferenceTargets.Num(); }
+
+	double GetBuildSeconds() const { return BuildSeconds; }
+
+private:
+	static TConstArrayView<int32> GetRow(const TArray<int32>& Offsets, const TArray<int32>& Values, int32 ObjectIndex)
+	{
+		if ((ObjectIndex < 0) || (ObjectIndex >= Offsets.Num() - 1))
+		{
+			return TConstArrayView<int32>();
+		}
+		return TConstArrayView<int32>(Values.GetData() + Offsets[ObjectIndex], Offsets[ObjectIndex + 1] - Offsets[ObjectIndex]);
+	}
+
+	int32 NumObjects = 0;
+
+	/* Row ObjectIndex spans [Offsets[ObjectIndex], Offsets[ObjectIndex + 1]) of its value table */
+	TArray<int32> ReferenceOffsets;
+	TArray<int32> ReferenceTargets;
+	TArray<int32> ReferencerOffsets;
+	TArray<int32> ReferencerSources;
+
+	/* Serial number of the object each slot held at the gather, 0 if it had none yet, INDEX_NONE for empty slots */
+	TArray<int32> SlotSerials;
+
+	double GatherSeconds = 0.0;
+	double BuildSeconds = 0.0;
+};
+
+/**
+ * Hands out a reference index, gathering it on the game thread and inverting it on a worker the first
+ * time it is asked for, and keeping it until the next garbage collection.
+ */
+class FUBrowseReferenceIndexCache : public TSharedFromThis<FUBrowseReferenceIndexCache>
+{
+public:
+	FUBrowseReferenceIndexCache();
+	~FUBrowseReferenceIndexCache();
+
+	/** The cached index, or null while there is none, in which case a build is started unless one is running */
+	TSharedPtr<const FUBrowseReferenceIndex> Request();
+
+	bool IsBuilding() const { return bBuilding; }
+
+	/** Broadcast on the game thread once a build finishes, callers that got null from Request should ask again */
+	FSimpleMulticastDelegate& OnIndexReady() { return IndexReady; }
+
+private:
+	void OnBuildComplete(TSharedRef<const FUBrowseReferenceIndex> BuiltIndex, uint32 BuildGeneration);
+
+	void OnPostGarbageCollect();
+
+	TSharedPtr<const FUBrowseReferenceIndex> Index;
+
+	FSimpleMulticastDelegate IndexReady;
+
+	/* Bumped by every garbage collection, a build started before one is stale */
+	uint32 Generation = 0;
+
+	bool bBuilding = false;
+};
@@ -0,0 +1,128 @@
+#include "UBrowseRowTextCache.h"
+#include "Styling/SlateIconFinder.h"
+#include "UObject/Class.h"
+#include "UObject/Object.h"
+
+#define LOCTEXT_NAMESPACE "UBrowseRowTextCache"
+
+FUBrowseRowTextCache::FUBrowseRowTextCache(int32 MaxRows)
+	: Rows(MaxRows)
+{
+}
+
+FText FUBrowseRowTextCache::GetName(const TWeakObjectPtr<UObject>& Handle)
+{
+	FRowText* Row = FormatColumn(Handle, Column_Name);
+	return Row != nullptr ? Row->Name : LOCTEXT("NoObject", "None");
+}
+
+FText FUBrowseRowTextCache::GetClassName(const TWeakObjectPtr<UObject>& Handle)
+{
+	FRowText* Row = FormatColumn(Handle, Column_ClassName);
+	return Row != nullptr ? Row->ClassName : FText::GetEmpty();
+}
+
+FText FUBrowseRowTextCache::GetPath(const TWeakObjectPtr<UObject>& Handle)
+{
+	FRowText* Row = FormatColumn(Handle, Column_Path);
+	return Row != nullptr ? Row->Path : FText::GetEmpty();
+}
+
+FText FUBrowseRowTextCache::GetOuterName(const TWeakObjectPtr<UObject>& Handle)
+{
+	FRowText* Row = FormatColumn(Handle, Column_OuterName);
+	return Row != nullptr ? Row->OuterName : LOCTEXT("NoOuter", "None");
+}
+
+FText FUBrowseRowTextCache::GetNumber(const TWeakObjectPtr<UObject>& Handle)
+{
+	FRowText* Row = FormatColumn(Handle, Column_Number);
+	return Row != nullptr ? Row->Number : FText::AsNumber(0);
+}
+
+FText FUBrowseRowTextCache::GetId(const TWeakObjectPtr<UObject>& Handle)
+{
+	FRowText* Row = FormatColumn(Handle, Column_Id);
+	return Row != nullptr ? Row->Id : FText::AsNumber(0);
+}
+
+const FSlateBrush* FUBrowseRowTextCache::GetClassIcon(const TWeakObjectPtr<UObject>& Handle)
+{
+	FRowText* Row = FormatColumn(Handle, Column_ClassIcon);
+	return Row != nullptr ? Row->ClassIcon : nullptr;
+}
+
+void FUBrowseRowTextCache::Reset()
+{
+	Rows.Empty(Rows.Max());
+}
+
+FUBrowseRowTextCache::FRowText* FUBrowseRowTextCache::FindOrAddRow(const TWeakObjectPtr<UObject>& Handle, UObject*& OutObject)
+{
+	OutObject = Handle.Get();
+	if (OutObject == nullptr)
+	{
+		return nullptr;
+	}
+
+	const FName ObjectName = OutObject->GetFName();
+	const UObject* Outer = OutObject->GetOuter();
+	FRowText* Row = Rows.FindAndTouch(Handle);
+	if ((Row != nullptr) && ((Row->ObjectName != ObjectName) || (Row->Outer != Outer)))
+	{
+		// renamed or moved since it was formatted, start over
+		*Row = FRowText();
+		Row->ObjectName = ObjectName;
+		Row->Outer = Outer;
+	}
+	else if (Row == nullptr)
+	{
+		FRowText NewRow;
+		NewRow.ObjectName = ObjectName;
+		NewRow.Outer = Outer;
+		Rows.Add(Handle, MoveTemp(NewRow));
+		Row = Rows.FindAndTouch(Handle);
+	}
+	return Row;
+}
+
+FUBrowseRowTextCache::FRowText* FUBrowseRowTextCache::FormatColumn(const TWeakObjectPtr<UObject>& Handle, EColumn Column)
+{
+	UObject* Object = nullptr;
+	FRowText* Row = FindOrAddRow(Handle, Object);
+	if ((Row == nullptr) || ((Row->FormattedColumns & Column) != 0))
+	{
+		return Row;
+	}
+
+	switch (Column)
+	{
+	case Column_Name:
+		Row->Name = FText::FromName(Row->ObjectName);
+		break;
+	case Column_ClassName:
+		Row->ClassName = Object->GetClass()->GetDisplayNameText();
+		break;
+	case Column_Path:
+		Row->Path = FText::FromString(Object->GetFullName());
+		break;
+	case Column_OuterName:
+		Row->OuterName = Row->Outer != nullptr ? FText::FromString(Row->Outer->GetName()) : LOCTEXT("NoOuter", "None");
+		break;
+	case Column_Number:
+		Row->Number = FText::AsNumber(Row->ObjectName.GetNumber());
+		break;
+	case Column_Id:
+		Row->Id = FText::AsNumber(Object->GetUniqueID());
+		break;
+	case Column_ClassIcon:
+		Row->ClassIcon = FSlateIconFinder::FindIconForClass(Object->GetClass()).GetSmallIcon();
+		break;
+	default:
+		break;
+	}
+	Row->FormattedColumns |= Column;
+	return Row;
+}
+
+#undef LOCTEXT_NAMESPACE
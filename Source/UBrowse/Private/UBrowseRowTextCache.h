@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+struct FSlateBrush;
+
+/**
+ * Formatted column text of object list rows, kept across list refreshes so regenerating or
+ * scrolling back to a row does not rebuild its strings.
+ *
+ * Entries are keyed by weak handle (object index + serial number), so a slot reused by a new
+ * object never hits a stale entry. Each column is formatted the first time it is asked for, and
+ * an entry is reformatted if its object has been renamed or moved to another outer since.
+ */
+class FUBrowseRowTextCache
+{
+public:
+	static constexpr int32 DefaultMaxRows = 8192;
+
+	explicit FUBrowseRowTextCache(int32 MaxRows = DefaultMaxRows);
+
+	FText GetName(const TWeakObjectPtr<UObject>& Handle);
+	FText GetClassName(const TWeakObjectPtr<UObject>& Handle);
+	FText GetPath(const TWeakObjectPtr<UObject>& Handle);
+	FText GetOuterName(const TWeakObjectPtr<UObject>& Handle);
+	FText GetNumber(const TWeakObjectPtr<UObject>& Handle);
+	FText GetId(const TWeakObjectPtr<UObject>& Handle);
+	const FSlateBrush* GetClassIcon(const TWeakObjectPtr<UObject>& Handle);
+
+	void Reset();
+
+private:
+	/* One bit per column in FRowText::FormattedColumns */
+	enum EColumn : uint8
+	{
+		Column_Name = 1 << 0,
+		Column_ClassName = 1 << 1,
+		Column_Path = 1 << 2,
+		Column_OuterName = 1 << 3,
+		Column_Number = 1 << 4,
+		Column_Id = 1 << 5,
+		Column_ClassIcon = 1 << 6
+	};
+
+	struct FRowText
+	{
+		/* What the text was formatted from, a rename or re-outer invalidates it */
+		FName ObjectName;
+		const UObject* Outer = nullptr;
+
+		/* Columns formatted so far */
+		uint8 FormattedColumns = 0;
+
+		FText Name;
+		FText ClassName;
+		FText Path;
+		FText OuterName;
+		FText Number;
+		FText Id;
+		const FSlateBrush* ClassIcon = nullptr;
+	};
+
+	/**
+	 * @param OutObject Receives the live object
+	 * @return The row's entry, added and made most recent, or null if the object is gone
+	 */
+	FRowText* FindOrAddRow(const TWeakObjectPtr<UObject>& Handle, UObject*& OutObject);
+
+	/** Format one column of a row unless it already has been */
+	FRowText* FormatColumn(const TWeakObjectPtr<UObject>& Handle, EColumn Column);
+
+	TLruCache<TWeakObjectPtr<UObject>, FRowText> Rows;
+};
@@ -5,6 +5,7 @@
 #include "ConnectionDrawingPolicy.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Editor.h"
+#include "Framework/Docking/TabManager.h"
 #include "GraphEditor.h"
 #include "GraphEditorActions.h"
 #include "SlateOptMacros.h"
@@ -14,6 +15,7 @@
 #include "UBrowseEditorCommands.h"
 #include "UBrowseGraph.h"
 #include "UBrowseNode.h"
+#include "SUBrowser.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/SBoxPanel.h"
@@ -94,9 +96,17 @@ END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 UEdGraphNode* FBrowseGraphSchemaAction_BrowseMode::PerformAction(class UEdGraph* ParentGraph, UEdGraphPin* FromPin, const FVector2D Location, bool bSelectNewNode/* = true*/)
 {
-	/* Here be dragons */
-	/* FSoundClassEditorUtilities::CreateSoundClass(ParentGraph, FromPin, Location, NewSoundClassName); */
-	return NULL;
+	UBrowseGraph* BrowseGraph = Cast<UBrowseGraph>(ParentGraph);
+	if (BrowseGraph != nullptr)
+	{
+		if (ReferenceDepth > 0)
+		{
+			BrowseGraph->SetReferenceDepth(ReferenceDepth);
+		}
+		BrowseGraph->SetMode(Mode);
+	}
+	// switching modes never places a node
+	return nullptr;
 }
 
 // Overridden connection drawing policy to use less curvy lines between nodes
@@ -122,12 +132,20 @@ UBrowseSchema::UBrowseSchema(FObjectInitializer const &Args)
 
 void UBrowseSchema::GetGraphContextActions(FGraphContextMenuBuilder& ContextMenuBuilder) const
 {
-	const FText Name = LOCTEXT("ChangeUBrowseMode", "Change UBrowse Mode");
-	const FText ToolTip = LOCTEXT("ChangeUBrowseModeTooltip", "Change viewing mode of UBrowse Graph");
+	const FText Category = LOCTEXT("ChangeUBrowseMode", "Change UBrowse Mode");
 
-	TSharedPtr<FBrowseGraphSchemaAction_BrowseMode> NewAction(new FBrowseGraphSchemaAction_BrowseMode(FText::GetEmpty(), Name, ToolTip, 0));
+	ContextMenuBuilder.AddAction(MakeShared<FBrowseGraphSchemaAction_BrowseMode>(Category,
+		LOCTEXT("OuterChainMode", "Outer Chain"),
+		LOCTEXT("OuterChainModeTooltip", "Show the outer chain of the object with its CDO, owner and blueprint links"),
+		0, EUBrowseGraphMode::Outers));
 
-	ContextMenuBuilder.AddAction(NewAction);
+	for (int32 Depth = 1; Depth <= 3; ++Depth)
+	{
+		ContextMenuBuilder.AddAction(MakeShared<FBrowseGraphSchemaAction_BrowseMode>(Category,
+			FText::Format(LOCTEXT("ReferencesMode", "References (depth {0})"), Depth),
+			FText::Format(LOCTEXT("ReferencesModeTooltip", "Show the objects referencing the object on the left and the objects it references on the right, up to {0} hops away"), Depth),
+			0, EUBrowseGraphMode::References, Depth));
+	}
 }
 
 
@@ -148,6 +166,33 @@ void UBrowseSchema::GetContextMenuActions(UToolMenu* Menu, UGraphNodeContextMenu
 				FSlateIcon(),
 				FUIAction(FExecuteAction::CreateStatic(&UBrowseSchema::BrowseClass, Node->GetUObject()->GetClass())));		
 		}
+		UBrowseGraph* BrowseGraph = Cast<UBrowseGraph>(Node->GetGraph());
+		if ((BrowseGraph != nullptr) && Node->IsSummary())
+		{
+			Section.AddMenuEntry(
+				"UBrowseExpandSummary",
+				FText::Format(LOCTEXT("UBrowseExpandSummaryLabel", "Show {0} More Inners"), UBrowseGraph::InnerPageSize),
+				LOCTEXT("UBrowseExpandSummaryToolTip", "Give the next page of the inners of this class nodes of their own."),
+				FSlateIcon(),
+				FUIAction(
+					FExecuteAction::CreateUObject(BrowseGraph, &UBrowseGraph::ExpandSummary, TWeakObjectPtr<UBrowseNode>(const_cast<UBrowseNode*>(Node))),
+					FCanExecuteAction::CreateLambda([WeakNode = TWeakObjectPtr<const UBrowseNode>(Node)]() { return WeakNode.IsValid() && (WeakNode->GetNumExpanded() < WeakNode->GetNumSummarized()); })));
+		}
+		else if (BrowseGraph != nullptr)
+		{
+			Section.AddMenuEntry(
+				"UBrowseExpandInners",
+				LOCTEXT("UBrowseExpandInnersLabel", "Expand Inners"),
+				LOCTEXT("UBrowseExpandInnersToolTip", "Show the objects this object is the outer of, grouped by class when there are many."),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateUObject(BrowseGraph, &UBrowseGraph::ExpandInners, TWeakObjectPtr<UBrowseNode>(const_cast<UBrowseNode*>(Node)))));
+			Section.AddMenuEntry(
+				"UBrowseWhyAlive",
+				LOCTEXT("UBrowseWhyAliveLabel", "Why Alive?"),
+				LOCTEXT("UBrowseWhyAliveToolTip", "Show the shortest chain of references from an object garbage collection keeps to this one."),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateStatic(&UBrowseSchema::ShowWhyAlive, TWeakObjectPtr<UObject>(const_cast<UObject*>(Node->GetUObject())))));
+		}
 		if (Node->GetUObject()->IsAsset())
 		{
 
@@ -185,6 +230,17 @@ void UBrowseSchema::BrowseClass(UClass* ClassObj)
 	return;
 }
 
+void UBrowseSchema::ShowWhyAlive(TWeakObjectPtr<UObject> Obj)
+{
+	// through the browser like the details panel button, so the panel's corner text follows
+	TSharedPtr<SDockTab> UBrowseTab = FGlobalTabmanager::Get()->TryInvokeTab(FUBrowseModule::UBrowseTabName);
+	if (UBrowseTab.IsValid() && Obj.IsValid())
+	{
+		TSharedRef<SUBrowser> UBrowserWidget = StaticCastSharedRef<SUBrowser>(UBrowseTab->GetContent());
+		UBrowserWidget->ShowWhyAlive(Obj.Get());
+	}
+}
+
 void UBrowseSchema::BrowseInstances(UObject* Obj)
 {
 	UClass* ClassObj = Obj->GetClass();
@@ -5,6 +5,7 @@
 #include "EdGraph/EdGraphSchema.h"
 // #include "ToolMenus.h"
 #include "K2Node.h"
+#include "UBrowseGraph.h"
 
 #include "UBrowseSchema.generated.h"
 
@@ -32,6 +33,20 @@ struct FBrowseGraphSchemaAction_BrowseMode : public FEdGraphSchemaAction
     {
     }
 
+    FBrowseGraphSchemaAction_BrowseMode(const FText& InNodeCategory, const FText& InMenuDesc, const FText& InToolTip,
+        const int32 InGrouping, EUBrowseGraphMode InMode, int32 InReferenceDepth = 0)
+        : FEdGraphSchemaAction(InNodeCategory, InMenuDesc, InToolTip, InGrouping)
+        , Mode(InMode)
+        , ReferenceDepth(InReferenceDepth)
+    {
+    }
+
+    /* Mode the graph switches to */
+    EUBrowseGraphMode Mode = EUBrowseGraphMode::Outers;
+
+    /* Reference hops to follow, 0 keeps the graph's current depth */
+    int32 ReferenceDepth = 0;
+
     //~ Begin FEdGraphSchemaAction Interface
     virtual FName GetTypeId() const override
     {
@@ -61,5 +76,7 @@ class UBrowseSchema : public UEdGraphSchema
 
     static void OpenNodeAsset(const UObject* Obj);
     static void BrowseClass(UClass* ClassObj);
+    /* Show why an object is alive in the browser's graph panel */
+    static void ShowWhyAlive(TWeakObjectPtr<UObject> Obj);
     static void BrowseInstances(UObject* Obj);
 };
\ No newline at end of file
@@ -0,0 +1,498 @@
+#include "UBrowseSnapshot.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UBrowseObjectSizes.h"
+#include "UBrowseObjectTracker.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Object.h"
+#include "UObject/UObjectArray.h"
+#include "UBrowseStats.h"
+
+#define LOCTEXT_NAMESPACE "UBrowseSnapshot"
+
+const TCHAR* FUBrowseSnapshot::FileExtension = TEXT("ubsnap");
+
+namespace
+{
+	/* Start of every snapshot file, each section offset is from the start of the file */
+	struct FSnapshotHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int64 CaptureTicks;
+		int32 NumStrings;
+		int32 NumClasses;
+		int32 NumObjects;
+		int32 Padding;
+		int64 StringDataSize;
+		int64 StringOffsetsOffset;
+		int64 StringDataOffset;
+		int64 ClassNamesOffset;
+		int64 ObjectClassesOffset;
+		int64 ObjectOutersOffset;
+		int64 ObjectNamesOffset;
+		int64 ObjectNumbersOffset;
+		int64 ObjectFlagsOffset;
+		int64 ObjectSizesOffset;
+	};
+
+	constexpr int64 SectionAlignment = 8;
+
+	/* Whether a header read from the start of a file belongs to a snapshot this build can read */
+	bool CheckHeader(const FSnapshotHeader& Header, FText& OutError)
+	{
+		if (Header.Magic != FUBrowseSnapshot::FileMagic)
+		{
+			OutError = LOCTEXT("SnapshotBadMagic", "the file is not a snapshot");
+			return false;
+		}
+		if (Header.Version != FUBrowseSnapshot::FileVersion)
+		{
+			OutError = FText::Format(LOCTEXT("SnapshotBadVersion", "version {0} is not supported"), FText::AsNumber(Header.Version));
+			return false;
+		}
+		return true;
+	}
+
+	FText MakeUnreadableError(const FString& Filename, const FText& Reason)
+	{
+		return FText::Format(LOCTEXT("SnapshotParseFailed", "{0} is not a readable snapshot: {1}"), FText::FromString(Filename), Reason);
+	}
+
+	/* Write a section at the next aligned offset, returning that offset */
+	int64 WriteSection(FArchive& Writer, const void* SectionData, int64 NumBytes)
+	{
+		static const uint8 Zeros[SectionAlignment] = {};
+		const int64 Padding = Align(Writer.Tell(), SectionAlignment) - Writer.Tell();
+		Writer.Serialize(const_cast<uint8*>(Zeros), Padding);
+		const int64 Offset = Writer.Tell();
+		Writer.Serialize(const_cast<void*>(SectionData), NumBytes);
+		return Offset;
+	}
+
+	template <typename ElementType>
+	bool ViewSection(const uint8* Data, int64 DataSize, int64 Offset, int64 Num, TArrayView<const ElementType>& OutView)
+	{
+		if ((Offset < 0) || (Num < 0) || (Num > MAX_int32) || (Offset % alignof(ElementType) != 0) || (Offset + Num * int64(sizeof(ElementType)) > DataSize))
+		{
+			return false;
+		}
+		OutView = TArrayView<const ElementType>(reinterpret_cast<const ElementType*>(Data + Offset), int32(Num));
+		return true;
+	}
+
+	/* Display form of a stored name, FName numbers are one past the suffix shown */
+	FString GetDisplayName(const FUBrowseSnapshot& Snapshot, int32 Row)
+	{
+		const int32 Number = Snapshot.GetObjectNumbers()[Row];
+		const FString PlainName = Snapshot.GetString(Snapshot.GetObjectNames()[Row]);
+		return Number != NAME_NO_NUMBER_INTERNAL ? FString::Printf(TEXT("%s_%d"), *PlainName, NAME_INTERNAL_TO_EXTERNAL(Number)) : PlainName;
+	}
+
+	struct FSnapshotTotals
+	{
+		int32 Count = 0;
+		int64 Size = 0;
+	};
+
+	/* Fold a snapshot into per class and per package totals, keyed by name so two captures can be matched up */
+	bool AggregateSnapshot(const FString& Filename, TMap<FString, FSnapshotTotals>& OutClasses, TMap<FString, FSnapshotTotals>& OutPackages, FDateTime& OutCaptureTime, FText& OutError)
+	{
+		TUniquePtr<FUBrowseSnapshot> Snapshot = FUBrowseSnapshot::Open(Filename, OutError);
+		if (!Snapshot.IsValid())
+		{
+			return false;
+		}
+		OutCaptureTime = Snapshot->GetCaptureTime();
+
+		// totals are gathered by index first so every class and package name is only decoded once
+		TArray<FSnapshotTotals> ClassTotals;
+		ClassTotals.SetNum(Snapshot->GetNumClasses());
+		TMap<int32, FSnapshotTotals> PackageTotals;
+
+		const TArray<int32> OutermostRows = Snapshot->FindOutermostRows();
+		const TArrayView<const int32> ObjectClasses = Snapshot->GetObjectClasses();
+		const TArrayView<const int64> ObjectSizes = Snapshot->GetObjectSizes();
+		for (int32 Row = 0; Row < Snapshot->GetNumObjects(); ++Row)
+		{
+			if (ClassTotals.IsValidIndex(ObjectClasses[Row]))
+			{
+				FSnapshotTotals& ClassTotal = ClassTotals[ObjectClasses[Row]];
+				++ClassTotal.Count;
+				ClassTotal.Size += ObjectSizes[Row];
+			}
+			FSnapshotTotals& PackageTotal = PackageTotals.FindOrAdd(OutermostRows[Row]);
+			++PackageTotal.Count;
+			PackageTotal.Size += ObjectSizes[Row];
+		}
+
+		for (int32 ClassIndex = 0; ClassIndex < ClassTotals.Num(); ++ClassIndex)
+		{
+			if (ClassTotals[ClassIndex].Count > 0)
+			{
+				OutClasses.Add(Snapshot->GetClassPathName(ClassIndex), ClassTotals[ClassIndex]);
+			}
+		}
+		for (const TPair<int32, FSnapshotTotals>& Package : PackageTotals)
+		{
+			FSnapshotTotals& Totals = OutPackages.FindOrAdd(GetDisplayName(*Snapshot, Package.Key));
+			Totals.Count += Package.Value.Count;
+			Totals.Size += Package.Value.Size;
+		}
+		return true;
+	}
+
+	void MakeDiffRows(const TMap<FString, FSnapshotTotals>& Before, const TMap<FString, FSnapshotTotals>& After, TArray<TSharedPtr<FUBrowseSnapshotDiff::FRow>>& OutRows)
+	{
+		TMap<FString, TSharedPtr<FUBrowseSnapshotDiff::FRow>> Rows;
+		for (const TPair<FString, FSnapshotTotals>& Entry : Before)
+		{
+			TSharedPtr<FUBrowseSnapshotDiff::FRow> Row = MakeShared<FUBrowseSnapshotDiff::FRow>();
+			Row->Name = Entry.Key;
+			Row->CountBefore = Entry.Value.Count;
+			Row->SizeBefore = Entry.Value.Size;
+			Rows.Add(Entry.Key, Row);
+		}
+		for (const TPair<FString, FSnapshotTotals>& Entry : After)
+		{
+			TSharedPtr<FUBrowseSnapshotDiff::FRow>& Row = Rows.FindOrAdd(Entry.Key);
+			if (!Row.IsValid())
+			{
+				Row = MakeShared<FUBrowseSnapshotDiff::FRow>();
+				Row->Name = Entry.Key;
+			}
+			Row->CountAfter = Entry.Value.Count;
+			Row->SizeAfter = Entry.Value.Size;
+		}
+
+		Rows.GenerateValueArray(OutRows);
+		OutRows.Sort([](const TSharedPtr<FUBrowseSnapshotDiff::FRow>& A, const TSharedPtr<FUBrowseSnapshotDiff::FRow>& B)
+		{
+			return A->GetSizeDelta() != B->GetSizeDelta() ? A->GetSizeDelta() > B->GetSizeDelta() : A->GetCountDelta() > B->GetCountDelta();
+		});
+	}
+}
+
+FString FUBrowseSnapshot::GetDefaultDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("UBrowse") / TEXT("Snapshots");
+}
+
+DECLARE_CYCLE_STAT(TEXT("Snapshot Capture"), STAT_UBrowse_SnapshotCapture, STATGROUP_UBrowse);
+DECLARE_CYCLE_STAT(TEXT("Snapshot Diff"), STAT_UBrowse_SnapshotDiff, STATGROUP_UBrowse);
+
+bool FUBrowseSnapshot::Capture(const FString& Filename, const FUBrowseObjectSizes* Sizes, FText& OutError)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_SnapshotCapture);
+
+	TArray<int64> StringOffsets;
+	TArray<uint8> StringData;
+	TArray<int32> ClassNames;
+	TArray<int32> ObjectClasses;
+	TArray<int32> ObjectOuters;
+	TArray<int32> ObjectNames;
+	TArray<int32> ObjectNumbers;
+	TArray<uint32> ObjectFlags;
+	TArray<int64> ObjectSizes;
+	int32 NumObjects = 0;
+	{
+		// the objects are only read while collection is held off, everything written out is copied into the columns under it
+		FGCScopeGuard GCGuard;
+
+		// gather the objects first, rows are then numbered densely and outers can be turned into rows
+		TArray<UObject*> Objects;
+		TArray<int32> SlotRows;
+		const int32 NumSlots = GUObjectArray.GetObjectArrayNum();
+		SlotRows.Init(INDEX_NONE, NumSlots);
+		Objects.Reserve(GUObjectArray.GetObjectArrayNumMinusAvailable());
+		for (int32 ObjectIndex = 0; ObjectIndex < NumSlots; ++ObjectIndex)
+		{
+			if (UObject* Object = FUBrowseObjectTracker::ResolveObject(ObjectIndex))
+			{
+				SlotRows[ObjectIndex] = Objects.Add(Object);
+			}
+		}
+
+		NumObjects = Objects.Num();
+		ObjectClasses.SetNumUninitialized(NumObjects);
+		ObjectOuters.SetNumUninitialized(NumObjects);
+		ObjectNames.SetNumUninitialized(NumObjects);
+		ObjectNumbers.SetNumUninitialized(NumObjects);
+		ObjectFlags.SetNumUninitialized(NumObjects);
+		ObjectSizes.SetNumUninitialized(NumObjects);
+
+		StringOffsets.Add(0);
+		auto AddString = [&StringOffsets, &StringData](const FString& String)
+		{
+			const FTCHARToUTF8 Utf8String(*String);
+			StringData.Append(reinterpret_cast<const uint8*>(Utf8String.Get()), Utf8String.Length());
+			StringOffsets.Add(StringData.Num());
+			return StringOffsets.Num() - 2;
+		};
+		TMap<FNameEntryId, int32> NameStrings;
+		TMap<const UClass*, int32> ClassIndices;
+
+		constexpr int32 RowsPerProgressFrame = 16 * 1024;
+		FScopedSlowTask SlowTask(float(NumObjects), LOCTEXT("CapturingSnapshot", "Capturing object snapshot..."));
+		SlowTask.MakeDialogDelayed(1.0f);
+
+		for (int32 Row = 0; Row < NumObjects; ++Row)
+		{
+			if (Row % RowsPerProgressFrame == 0)
+			{
+				SlowTask.EnterProgressFrame(float(FMath::Min(RowsPerProgressFrame, NumObjects - Row)));
+			}
+
+			UObject* Object = Objects[Row];
+			const UClass* Class = Object->GetClass();
+			int32* ClassIndex = ClassIndices.Find(Class);
+			if (ClassIndex == nullptr)
+			{
+				ClassIndex = &ClassIndices.Add(Class, ClassNames.Add(AddString(Class->GetPathName())));
+			}
+			ObjectClasses[Row] = *ClassIndex;
+
+			const UObject* Outer = Object->GetOuter();
+			const int32 OuterSlot = Outer != nullptr ? GUObjectArray.ObjectToIndex(Outer) : INDEX_NONE;
+			ObjectOuters[Row] = SlotRows.IsValidIndex(OuterSlot) ? SlotRows[OuterSlot] : INDEX_NONE;
+
+			const FName Name = Object->GetFName();
+			int32* NameString = NameStrings.Find(Name.GetComparisonIndex());
+			if (NameString == nullptr)
+			{
+				NameString = &NameStrings.Add(Name.GetComparisonIndex(), AddString(Name.GetPlainNameString()));
+			}
+			ObjectNames[Row] = *NameString;
+			ObjectNumbers[Row] = Name.GetNumber();
+			ObjectFlags[Row] = uint32(Object->GetFlags());
+
+			const FUBrowseObjectSize* KnownSize = Sizes != nullptr ? Sizes->Find(Object) : nullptr;
+			ObjectSizes[Row] = KnownSize != nullptr ? KnownSize->Exclusive : FUBrowseObjectSizes::MeasureExclusive(Object);
+		}
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid())
+	{
+		OutError = FText::Format(LOCTEXT("SnapshotOpenForWriteFailed", "Could not create {0}"), FText::FromString(Filename));
+		return false;
+	}
+
+	// a zeroed placeholder holds the header's place, without the magic a capture cut short is rejected on open
+	FSnapshotHeader Header = {};
+	Writer->Serialize(&Header, sizeof(Header));
+
+	Header.StringOffsetsOffset = WriteSection(*Writer, StringOffsets.GetData(), StringOffsets.NumBytes());
+	Header.StringDataOffset = WriteSection(*Writer, StringData.GetData(), StringData.NumBytes());
+	Header.ClassNamesOffset = WriteSection(*Writer, ClassNames.GetData(), ClassNames.NumBytes());
+	Header.ObjectClassesOffset = WriteSection(*Writer, ObjectClasses.GetData(), ObjectClasses.NumBytes());
+	Header.ObjectOutersOffset = WriteSection(*Writer, ObjectOuters.GetData(), ObjectOuters.NumBytes());
+	Header.ObjectNamesOffset = WriteSection(*Writer, ObjectNames.GetData(), ObjectNames.NumBytes());
+	Header.ObjectNumbersOffset = WriteSection(*Writer, ObjectNumbers.GetData(), ObjectNumbers.NumBytes());
+	Header.ObjectFlagsOffset = WriteSection(*Writer, ObjectFlags.GetData(), ObjectFlags.NumBytes());
+	Header.ObjectSizesOffset = WriteSection(*Writer, ObjectSizes.GetData(), ObjectSizes.NumBytes());
+
+	// the real header only goes in once every section is written
+	Header.Magic = FileMagic;
+	Header.Version = FileVersion;
+	Header.CaptureTicks = FDateTime::UtcNow().GetTicks();
+	Header.NumStrings = StringOffsets.Num() - 1;
+	Header.NumClasses = ClassNames.Num();
+	Header.NumObjects = NumObjects;
+	Header.StringDataSize = StringData.Num();
+	Writer->Seek(0);
+	Writer->Serialize(&Header, sizeof(Header));
+
+	const bool bWritten = Writer->Close() && !Writer->IsError();
+	if (!bWritten)
+	{
+		OutError = FText::Format(LOCTEXT("SnapshotWriteFailed", "Failed writing {0}"), FText::FromString(Filename));
+	}
+	return bWritten;
+}
+
+bool FUBrowseSnapshot::ReadHeader(const FString& Filename, FHeader& OutHeader, FText& OutError)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader.IsValid())
+	{
+		OutError = FText::Format(LOCTEXT("SnapshotOpenFailed", "Could not open {0}"), FText::FromString(Filename));
+		return false;
+	}
+	if (Reader->TotalSize() < int64(sizeof(FSnapshotHeader)))
+	{
+		OutError = MakeUnreadableError(Filename, LOCTEXT("SnapshotTruncated", "the file is too short"));
+		return false;
+	}
+
+	FSnapshotHeader Header;
+	Reader->Serialize(&Header, sizeof(Header));
+	if (Reader->IsError())
+	{
+		OutError = FText::Format(LOCTEXT("SnapshotReadFailed", "Failed reading {0}"), FText::FromString(Filename));
+		return false;
+	}
+	FText Reason;
+	if (!CheckHeader(Header, Reason))
+	{
+		OutError = MakeUnreadableError(Filename, Reason);
+		return false;
+	}
+
+	OutHeader.CaptureTime = FDateTime(Header.CaptureTicks);
+	OutHeader.NumObjects = Header.NumObjects;
+	OutHeader.NumClasses = Header.NumClasses;
+	return true;
+}
+
+TUniquePtr<FUBrowseSnapshot> FUBrowseSnapshot::Open(const FString& Filename, FText& OutError)
+{
+	TUniquePtr<FUBrowseSnapshot> Snapshot(new FUBrowseSnapshot);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*Filename);
+	if (MappedResult.HasValue())
+	{
+		Snapshot->MappedFile = MappedResult.StealValue();
+		Snapshot->MappedRegion.Reset(Snapshot->MappedFile->MapRegion(0, Snapshot->MappedFile->GetFileSize()));
+	}
+	if (!Snapshot->MappedRegion.IsValid())
+	{
+		OutError = FText::Format(LOCTEXT("SnapshotOpenFailed", "Could not open {0}"), FText::FromString(Filename));
+		return nullptr;
+	}
+	Snapshot->Data = Snapshot->MappedRegion->GetMappedPtr();
+	Snapshot->DataSize = Snapshot->MappedRegion->GetMappedSize();
+
+	FText Reason;
+	if (!Snapshot->Parse(Reason))
+	{
+		OutError = MakeUnreadableError(Filename, Reason);
+		return nullptr;
+	}
+	return Snapshot;
+}
+
+FUBrowseSnapshot::~FUBrowseSnapshot()
+{
+	// the views go away with the region, which has to be released before its file
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FUBrowseSnapshot::Parse(FText& OutError)
+{
+	if (DataSize < int64(sizeof(FSnapshotHeader)))
+	{
+		OutError = LOCTEXT("SnapshotTruncated", "the file is too short");
+		return false;
+	}
+	FSnapshotHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+	if (!CheckHeader(Header, OutError))
+	{
+		return false;
+	}
+
+	CaptureTime = FDateTime(Header.CaptureTicks);
+	const bool bValid = (Header.NumStrings >= 0)
+		&& ViewSection(Data, DataSize, Header.StringOffsetsOffset, int64(Header.NumStrings) + 1, StringOffsets)
+		&& ViewSection(Data, DataSize, Header.StringDataOffset, Header.StringDataSize, StringData)
+		&& ViewSection(Data, DataSize, Header.ClassNamesOffset, Header.NumClasses, ClassNames)
+		&& ViewSection(Data, DataSize, Header.ObjectClassesOffset, Header.NumObjects, ObjectClasses)
+		&& ViewSection(Data, DataSize, Header.ObjectOutersOffset, Header.NumObjects, ObjectOuters)
+		&& ViewSection(Data, DataSize, Header.ObjectNamesOffset, Header.NumObjects, ObjectNames)
+		&& ViewSection(Data, DataSize, Header.ObjectNumbersOffset, Header.NumObjects, ObjectNumbers)
+		&& ViewSection(Data, DataSize, Header.ObjectFlagsOffset, Header.NumObjects, ObjectFlags)
+		&& ViewSection(Data, DataSize, Header.ObjectSizesOffset, Header.NumObjects, ObjectSizes);
+	if (!bValid)
+	{
+		OutError = LOCTEXT("SnapshotBadSections", "a section lies outside the file");
+	}
+	return bValid;
+}
+
+FString FUBrowseSnapshot::GetString(int32 StringIndex) const
+{
+	if (!StringOffsets.IsValidIndex(StringIndex + 1) || (StringIndex < 0))
+	{
+		return FString();
+	}
+	const int64 Begin = StringOffsets[StringIndex];
+	const int64 End = StringOffsets[StringIndex + 1];
+	if ((Begin < 0) || (End < Begin) || (End > StringData.Num()))
+	{
+		return FString();
+	}
+	const FUTF8ToTCHAR String(reinterpret_cast<const ANSICHAR*>(StringData.GetData() + Begin), int32(End - Begin));
+	return FString(String.Length(), String.Get());
+}
+
+TArray<int32> FUBrowseSnapshot::FindOutermostRows() const
+{
+	constexpr int32 Unresolved = INDEX_NONE;
+	constexpr int32 Visiting = -2;
+
+	const int32 NumObjects = GetNumObjects();
+	TArray<int32> Outermost;
+	Outermost.Init(Unresolved, NumObjects);
+
+	TArray<int32> Chain;
+	for (int32 Row = 0; Row < NumObjects; ++Row)
+	{
+		// climb until a row that is already resolved or has no outer, then resolve the whole chain to it
+		int32 Current = Row;
+		while (Outermost[Current] == Unresolved)
+		{
+			Outermost[Current] = Visiting;
+			Chain.Add(Current);
+			const int32 Outer = ObjectOuters[Current];
+			if ((Outer < 0) || (Outer >= NumObjects) || (Outermost[Outer] == Visiting))
+			{
+				// a cycle can only come from a damaged file, it is cut where it closes
+				Outermost[Current] = Current;
+				break;
+			}
+			Current = Outer;
+		}
+		const int32 Root = Outermost[Current];
+		for (int32 ChainRow : Chain)
+		{
+			Outermost[ChainRow] = Root;
+		}
+		Chain.Reset();
+	}
+	return Outermost;
+}
+
+TSharedPtr<FUBrowseSnapshotDiff> FUBrowseSnapshotDiff::Compute(const FString& BeforeFile, const FString& AfterFile, FText& OutError)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UBrowse_SnapshotDiff);
+
+	TSharedPtr<FUBrowseSnapshotDiff> Diff = MakeShared<FUBrowseSnapshotDiff>();
+	Diff->BeforeFilename = BeforeFile;
+	Diff->AfterFilename = AfterFile;
+
+	TMap<FString, FSnapshotTotals> BeforeClasses;
+	TMap<FString, FSnapshotTotals> BeforePackages;
+	if (!AggregateSnapshot(BeforeFile, BeforeClasses, BeforePackages, Diff->BeforeTime, OutError))
+	{
+		return nullptr;
+	}
+	TMap<FString, FSnapshotTotals> AfterClasses;
+	TMap<FString, FSnapshotTotals> AfterPackages;
+	if (!AggregateSnapshot(AfterFile, AfterClasses, AfterPackages, Diff->AfterTime, OutError))
+	{
+		return nullptr;
+	}
+
+	MakeDiffRows(BeforeClasses, AfterClasses, Diff->Classes);
+	MakeDiffRows(BeforePackages, AfterPackages, Diff->Packages);
+	return Diff;
+}
+
+#undef LOCTEXT_NAMESPACE
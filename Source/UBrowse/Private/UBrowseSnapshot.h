@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Misc/DateTime.h"
+
+class FUBrowseObjectSizes;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * A census of every live object written to disk, read back through a memory mapping.
+ *
+ * The file is a fixed header followed by 8 byte aligned sections: a string table (offsets into one
+ * UTF-8 blob), a class table (string index of each class path) and then one column per object field.
+ * Names are stored once in the string table with their number kept apart, outers are row indices into
+ * the same columns, so a capture of millions of objects stays in the tens of megabytes and reading a
+ * column is just a view onto the mapping.
+ */
+class FUBrowseSnapshot
+{
+public:
+	static constexpr uint32 FileMagic = 0x4E534255; // "UBSN"
+	static constexpr uint32 FileVersion = 1;
+
+	/** Extension of snapshot files, without the dot */
+	static const TCHAR* FileExtension;
+
+	/** @return The folder captures are written to by default */
+	static FString GetDefaultDirectory();
+
+	/**
+	 * Write every live object to a snapshot file.
+	 *
+	 * @param Filename Where to write, the folder is created if needed
+	 * @param Sizes    Sizes measured so far, anything not in there is measured during the capture
+	 * @param OutError Why the file could not be written
+	 */
+	static bool Capture(const FString& Filename, const FUBrowseObjectSizes* Sizes, FText& OutError);
+
+	/* What the header of a snapshot file says, without the sections behind it */
+	struct FHeader
+	{
+		FDateTime CaptureTime;
+		int32 NumObjects = 0;
+		int32 NumClasses = 0;
+	};
+
+	/**
+	 * Read just the header of a snapshot file, enough to tell captures apart without mapping them.
+	 *
+	 * @return false with OutError set if the file is missing or its header is not a snapshot's
+	 */
+	static bool ReadHeader(const FString& Filename, FHeader& OutHeader, FText& OutError);
+
+	/**
+	 * Map a snapshot file for reading.
+	 *
+	 * @return The snapshot, or null with OutError set if the file is missing or not a snapshot
+	 */
+	static TUniquePtr<FUBrowseSnapshot> Open(const FString& Filename, FText& OutError);
+
+	~FUBrowseSnapshot();
+
+	int32 GetNumObjects() const { return ObjectClasses.Num(); }
+	int32 GetNumClasses() const { return ClassNames.Num(); }
+	FDateTime GetCaptureTime() const { return CaptureTime; }
+
+	FString GetString(int32 StringIndex) const;
+
+	/** @return Path name of a class of the class table */
+	FString GetClassPathName(int32 ClassIndex) const { return GetString(ClassNames[ClassIndex]); }
+
+	/* One entry per object */
+	TArrayView<const int32> GetObjectClasses() const { return ObjectClasses; }
+	TArrayView<const int32> GetObjectOuters() const { return ObjectOuters; }
+	TArrayView<const int32> GetObjectNames() const { return ObjectNames; }
+	TArrayView<const int32> GetObjectNumbers() const { return ObjectNumbers; }
+	TArrayView<const uint32> GetObjectFlags() const { return ObjectFlags; }
+	TArrayView<const int64> GetObjectSizes() const { return ObjectSizes; }
+
+	/**
+	 * @return For each object, the row of the outermost object above it (its package), itself if it has no outer
+	 */
+	TArray<int32> FindOutermostRows() const;
+
+private:
+	FUBrowseSnapshot() = default;
+
+	/* Set up the section views over Data, false if the layout does not fit in DataSize */
+	bool Parse(FText& OutError);
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	FDateTime CaptureTime;
+	TArrayView<const int64> StringOffsets;
+	TArrayView<const uint8> StringData;
+	TArrayView<const int32> ClassNames;
+	TArrayView<const int32> ObjectClasses;
+	TArrayView<const int32> ObjectOuters;
+	TArrayView<const int32> ObjectNames;
+	TArrayView<const int32> ObjectNumbers;
+	TArrayView<const uint32> ObjectFlags;
+	TArrayView<const int64> ObjectSizes;
+};
+
+/** Object count and size growth between two snapshots, per class and per package */
+struct FUBrowseSnapshotDiff
+{
+	struct FRow
+	{
+		FString Name;
+		int32 CountBefore = 0;
+		int32 CountAfter = 0;
+		int64 SizeBefore = 0;
+		int64 SizeAfter = 0;
+
+		int32 GetCountDelta() const { return CountAfter - CountBefore; }
+		int64 GetSizeDelta() const { return SizeAfter - SizeBefore; }
+	};
+
+	FString BeforeFilename;
+	FString AfterFilename;
+	FDateTime BeforeTime;
+	FDateTime AfterTime;
+
+	/* Every class and package found in either snapshot, largest size growth first */
+	TArray<TSharedPtr<FRow>> Classes;
+	TArray<TSharedPtr<FRow>> Packages;
+
+	/**
+	 * Compare two snapshot files. Each is mapped, folded into per class/package totals and released
+	 * before the next one is opened, so only the totals are ever held in memory.
+	 */
+	static TSharedPtr<FUBrowseSnapshotDiff> Compute(const FString& BeforeFile, const FString& AfterFile, FText& OutError);
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/* stat UBrowse, every cycle stat of the plugin also shows up as a timing event in Unreal Insights */
+DECLARE_STATS_GROUP(TEXT("UBrowse"), STATGROUP_UBrowse, STATCAT_Advanced);
@@ -39,17 +39,7 @@ public:
 		return MakeShareable(new FBrowserObject);
 	}
 
-	FBrowserObject() : Object(nullptr)
-	{
-	};
-
-	FBrowserObject(TWeakObjectPtr<UObject> InObject) : Object(InObject)
-	{
-	};
-
 	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailLayout) override;
-
-	TWeakObjectPtr<UObject> Object;
 };
 
 class FToolBarBuilder;
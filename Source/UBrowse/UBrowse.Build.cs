@@ -49,7 +49,9 @@ public class UBrowse : ModuleRules
                 "Engine", 
                 "Slate", 
                 "SlateCore",	
-				"ToolMenus"
+				"ToolMenus",
+				"DesktopPlatform",
+				"Json"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);